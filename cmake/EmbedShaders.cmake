@@ -0,0 +1,24 @@
+# Script mode: cmake -DSHADER_DIR=<dir> -DOUTPUT=<header> -P EmbedShaders.cmake
+# Writes every <dir>/*.glsl into a header as constexpr string data, so built-in shaders need no file I/O
+
+file(GLOB SHADER_FILES "${SHADER_DIR}/*.glsl")
+list(SORT SHADER_FILES)
+
+set(CONTENT "// Generated by cmake/EmbedShaders.cmake from ${SHADER_DIR}, do not edit\n")
+string(APPEND CONTENT "#pragma once\n\n#include <string_view>\n\nnamespace gplot::graphics::embedded\n{\n")
+string(APPEND CONTENT "    struct EmbeddedShader\n    {\n        std::string_view name;\n        std::string_view source;\n    };\n\n")
+
+set(ENTRIES "")
+foreach (SHADER_FILE ${SHADER_FILES})
+    get_filename_component(SHADER_NAME ${SHADER_FILE} NAME)
+    string(MAKE_C_IDENTIFIER ${SHADER_NAME} SHADER_ID)
+    string(TOUPPER ${SHADER_ID} SHADER_ID)
+
+    file(READ ${SHADER_FILE} SHADER_SOURCE)
+    string(APPEND CONTENT "    inline constexpr std::string_view ${SHADER_ID} = R\"glsl(${SHADER_SOURCE})glsl\";\n\n")
+    string(APPEND ENTRIES "        EmbeddedShader { \"${SHADER_NAME}\", ${SHADER_ID} },\n")
+endforeach ()
+
+string(APPEND CONTENT "    inline constexpr EmbeddedShader SHADERS[] =\n    {\n${ENTRIES}    };\n}\n")
+
+file(WRITE ${OUTPUT} "${CONTENT}")
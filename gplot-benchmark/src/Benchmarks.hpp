@@ -0,0 +1,67 @@
+#pragma once
+
+#include <Core/Math.hpp>
+
+#include <cmath>
+#include <chrono>
+#include <random>
+#include <vector>
+#include <cstdio>
+
+namespace benchmark
+{
+    constexpr int CANVAS_WIDTH = 1920;
+    constexpr int CANVAS_HEIGHT = 1080;
+
+    template<typename F>
+    double MeasureMs(int iterations, F&& task)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < iterations; i++)
+        {
+            task();
+        }
+        const auto end = std::chrono::steady_clock::now();
+
+        return std::chrono::duration<double, std::milli>(end - start).count() / iterations;
+    }
+
+    inline std::vector<std::vector<gplot::core::Vertex>> GenerateNoisySines(size_t lines, size_t points)
+    {
+        std::mt19937 rng(42);
+        std::normal_distribution<float> noise(0.0F, 0.05F);
+
+        std::vector<std::vector<gplot::core::Vertex>> result(lines);
+        for (size_t l = 0; l < lines; l++)
+        {
+            result[l].resize(points);
+            for (size_t i = 0; i < points; i++)
+            {
+                const float x = static_cast<float>(i) / static_cast<float>(points) * 2.0F - 1.0F;
+                result[l][i].pos = { x, std::sin(x * 20.0F + static_cast<float>(l)) * 0.5F + noise(rng) };
+            }
+        }
+
+        return result;
+    }
+
+    void RunLTTB();
+
+    void RunLines();
+
+    void RunReadback();
+
+    void RunDashboard();
+
+    void RunSeries();
+
+    void RunPrecision();
+
+    void RunBounds();
+
+    void RunColumnar();
+
+    void RunCsv();
+
+    void RunDriveIO();
+}
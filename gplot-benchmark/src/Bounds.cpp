@@ -0,0 +1,42 @@
+#include "Benchmarks.hpp"
+
+#include <Core/Math.hpp>
+
+#include <algorithm>
+
+void benchmark::RunBounds()
+{
+    constexpr size_t POINTS = 64'000'000;
+    constexpr int ITERATIONS = 5;
+
+    std::vector<gplot::core::Vertex> vertices(POINTS);
+    for (size_t i = 0; i < POINTS; i++)
+    {
+        const float x = static_cast<float>(i) / static_cast<float>(POINTS);
+        vertices[i].pos = { x, std::sin(x * 1000.0F) };
+    }
+
+    // The per-vertex loop every caller used to repeat
+    gplot::core::RectF loop_bounds;
+    const double loop_ms = MeasureMs(ITERATIONS, [&]()
+    {
+        gplot::core::RectF bounds;
+        for (const auto& vertex : vertices)
+        {
+            bounds.min.x = std::min(bounds.min.x, vertex.pos.x);
+            bounds.min.y = std::min(bounds.min.y, vertex.pos.y);
+            bounds.max.x = std::max(bounds.max.x, vertex.pos.x);
+            bounds.max.y = std::max(bounds.max.y, vertex.pos.y);
+        }
+        loop_bounds = bounds;
+    });
+
+    gplot::core::DataRange range;
+    const double scan_ms = MeasureMs(ITERATIONS, [&]() { range = gplot::core::ScanDataRange(vertices); });
+
+    const double bytes = static_cast<double>(POINTS * sizeof(gplot::core::Vertex));
+
+    std::printf("bounds: %zu points, %s kernel\n", POINTS, gplot::core::GetScanKernelName());
+    std::printf("  scalar loop      %10.3f ms, %6.2f GB/s\n", loop_ms, bytes / loop_ms / 1e6);
+    std::printf("  ScanDataRange    %10.3f ms, %6.2f GB/s%s\n", scan_ms, bytes / scan_ms / 1e6, range.bounds == loop_bounds ? "" : ", bounds differ");
+}
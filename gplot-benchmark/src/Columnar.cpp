@@ -0,0 +1,67 @@
+#include "Benchmarks.hpp"
+
+#include <Core/DriveIO.hpp>
+#include <Core/ColumnarFile.hpp>
+
+#include <filesystem>
+
+void benchmark::RunColumnar()
+{
+    constexpr size_t POINTS = 64'000'000;
+    constexpr size_t WINDOW = 1'000'000;
+    constexpr int ITERATIONS = 20;
+
+    const auto path = (std::filesystem::temp_directory_path() / "gplot-benchmark-columnar.gcol").string();
+
+    {
+        std::vector<gplot::core::Vertex> vertices(POINTS);
+        std::vector<float> values(POINTS);
+        for (size_t i = 0; i < POINTS; i++)
+        {
+            const float x = static_cast<float>(i) / static_cast<float>(POINTS);
+            vertices[i].pos = { x, std::sin(x * 1000.0F) };
+            values[i] = std::cos(x * 100.0F);
+        }
+
+        const gplot::core::ColumnarFile::ColumnSource columns[] =
+        {
+            { "trace", gplot::core::ColumnType::eVertex, std::as_bytes(std::span(vertices)) },
+            { "value", gplot::core::ColumnType::eFloat32, std::as_bytes(std::span(values)) },
+        };
+
+        if (!gplot::core::ColumnarFile::Write(path, columns))
+        {
+            return;
+        }
+    }
+
+    const double size_mb = static_cast<double>(std::filesystem::file_size(path)) / (1024.0 * 1024.0);
+
+    const double open_ms = MeasureMs(ITERATIONS, [&]()
+    {
+        const gplot::core::ColumnarFile file(path);
+        (void)file.GetColumns();
+    });
+
+    // Opens the file and reads one visible window out of the middle of the trace
+    gplot::core::DataRange range;
+    const double window_ms = MeasureMs(ITERATIONS, [&]()
+    {
+        const gplot::core::ColumnarFile file(path);
+        const auto trace = file.GetVertices(file.FindColumn("trace").value_or(0));
+
+        file.Prefetch(0, POINTS / 2, WINDOW);
+        range = gplot::core::ScanDataRange(trace.subspan(POINTS / 2, WINDOW));
+    });
+
+    gplot::core::DriveIO drive_io;
+    const double read_ms = MeasureMs(1, [&]() { (void)drive_io.Read(path); });
+
+    std::printf("columnar: %zu points, %.1f MB file, %zu point window\n", POINTS, size_mb, WINDOW);
+    std::printf("  mapped open            %10.3f ms\n", open_ms);
+    std::printf("  open + window          %10.3f ms\n", window_ms);
+    std::printf("  DriveIO::Read          %10.3f ms\n", read_ms);
+
+    std::error_code error;
+    std::filesystem::remove(path, error);
+}
@@ -0,0 +1,85 @@
+#include "Benchmarks.hpp"
+
+#include <Core/DriveIO.hpp>
+#include <Core/CsvFile.hpp>
+
+#include <string>
+#include <charconv>
+#include <fstream>
+#include <filesystem>
+
+void benchmark::RunCsv()
+{
+    constexpr size_t ROWS = 4'000'000;
+    constexpr size_t COLUMNS = 4;
+    constexpr int ITERATIONS = 3;
+
+    const auto path = (std::filesystem::temp_directory_path() / "gplot-benchmark-csv.csv").string();
+
+    {
+        std::mt19937 rng(42);
+        std::normal_distribution<float> noise(0.0F, 1.0F);
+
+        gplot::core::DriveIO::file_data text;
+        text.reserve(ROWS * COLUMNS * 14);
+
+        const std::string_view header = "time,voltage,current,temperature\n";
+        text.insert(text.end(), header.begin(), header.end());
+
+        char buffer[32];
+        for (size_t i = 0; i < ROWS; i++)
+        {
+            const float row[COLUMNS] = { static_cast<float>(i) * 0.001F, std::sin(static_cast<float>(i) * 0.01F) * 5.0F, noise(rng), 20.0F + noise(rng) * 0.1F };
+            for (size_t column = 0; column < COLUMNS; column++)
+            {
+                const auto result = std::to_chars(buffer, buffer + sizeof(buffer), row[column]);
+                text.insert(text.end(), buffer, result.ptr);
+                text.push_back(column + 1 < COLUMNS ? ',' : '\n');
+            }
+        }
+
+        gplot::core::DriveIO drive_io;
+        if (!drive_io.Write(path, text))
+        {
+            return;
+        }
+    }
+
+    const double size_mb = static_cast<double>(std::filesystem::file_size(path)) / (1024.0 * 1024.0);
+
+    size_t rows = 0;
+    const double load_ms = MeasureMs(ITERATIONS, [&]()
+    {
+        const gplot::core::CsvFile file(path);
+        rows = file.GetRowCount();
+    });
+
+    // Line by line istream parsing, the usual way to load such a file
+    size_t baseline_rows = 0;
+    const double baseline_ms = MeasureMs(1, [&]()
+    {
+        std::vector<std::vector<float>> columns(COLUMNS);
+
+        std::ifstream file(path);
+        std::string line;
+        std::getline(file, line);
+        while (std::getline(file, line))
+        {
+            const char* cursor = line.c_str();
+            for (auto& column : columns)
+            {
+                char* end;
+                column.push_back(std::strtof(cursor, &end));
+                cursor = *end ? end + 1 : end;
+            }
+        }
+        baseline_rows = columns.front().size();
+    });
+
+    std::printf("csv: %zu rows, %zu columns, %.1f MB file, %s delimiter kernel\n", ROWS, COLUMNS, size_mb, gplot::core::CsvFile::GetDelimiterKernelName());
+    std::printf("  CsvFile                %10.3f ms  %8.1f MB/s  %zu rows\n", load_ms, size_mb / load_ms * 1000.0, rows);
+    std::printf("  getline + strtof       %10.3f ms  %8.1f MB/s  %zu rows\n", baseline_ms, size_mb / baseline_ms * 1000.0, baseline_rows);
+
+    std::error_code error;
+    std::filesystem::remove(path, error);
+}
@@ -0,0 +1,86 @@
+#include "Benchmarks.hpp"
+
+#include <Plotting/Plotting.hpp>
+#include <Graphics/Renderer.hpp>
+#include <Graphics/StateCache.hpp>
+
+#include <memory>
+
+#include <glad/glad.h>
+
+void benchmark::RunDashboard()
+{
+    constexpr int COLUMNS = 4;
+    constexpr int ROWS = 4;
+    constexpr size_t SERIES = 4;
+    constexpr size_t POINTS = 2'000;
+    constexpr int FRAMES = 20;
+
+    constexpr int PLOT_WIDTH = CANVAS_WIDTH / COLUMNS;
+    constexpr int PLOT_HEIGHT = CANVAS_HEIGHT / ROWS;
+
+    const auto lines = GenerateNoisySines(SERIES, POINTS);
+    const gplot::core::RectF bounds { { -1.0F, -1.0F }, { 1.0F, 1.0F } };
+
+    std::printf("dashboard: %d x %d plots, %zu series x %zu points each\n", COLUMNS, ROWS, SERIES, POINTS);
+
+    std::vector<std::unique_ptr<gplot::Plotter>> plotters;
+    for (int i = 0; i < COLUMNS * ROWS; i++)
+    {
+        auto& plotter = plotters.emplace_back(std::make_unique<gplot::Plotter>());
+        plotter->SetCanvasSize(PLOT_WIDTH, PLOT_HEIGHT);
+
+        for (size_t s = 0; s < SERIES; s++)
+        {
+            (void)plotter->AddSeries(lines[s], glm::vec4(1.0F, 0.25F * static_cast<float>(s), 0.0F, 1.0F));
+        }
+    }
+
+    const auto viewport = [](int index)
+    {
+        return glm::ivec4((index % COLUMNS) * PLOT_WIDTH, (index / COLUMNS) * PLOT_HEIGHT, PLOT_WIDTH, PLOT_HEIGHT);
+    };
+
+    auto& cache = gplot::graphics::StateCache::Get();
+
+    cache.ResetCounters();
+    const double immediate_ms = MeasureMs(FRAMES, [&]()
+    {
+        glClear(GL_COLOR_BUFFER_BIT);
+        for (int i = 0; i < COLUMNS * ROWS; i++)
+        {
+            const auto area = viewport(i);
+            glViewport(area.x, area.y, area.z, area.w);
+            plotters[i]->Render(bounds, { }, 0.005F, 0.1F);
+        }
+        glFinish();
+    });
+    const auto immediate_binds = cache.GetCounters();
+
+    gplot::graphics::Renderer renderer;
+    renderer.ResizeWindowCanvas(CANVAS_WIDTH, CANVAS_HEIGHT);
+
+    cache.ResetCounters();
+    const double deferred_ms = MeasureMs(FRAMES, [&]()
+    {
+        glClear(GL_COLOR_BUFFER_BIT);
+
+        renderer.PrepareFrame();
+        for (int i = 0; i < COLUMNS * ROWS; i++)
+        {
+            renderer.SetTarget(gplot::graphics::RenderTarget { 0, viewport(i) });
+            plotters[i]->Record(renderer, bounds, { }, 0.005F, 0.1F);
+        }
+        renderer.RenderCurrent();
+
+        glFinish();
+    });
+    const auto deferred_binds = cache.GetCounters();
+    const auto& statistics = renderer.GetStatistics();
+
+    glViewport(0, 0, CANVAS_WIDTH, CANVAS_HEIGHT);
+
+    std::printf("  per plot render %10.3f ms, %zu binds issued per frame\n", immediate_ms, immediate_binds.issued / FRAMES);
+    std::printf("  shared renderer %10.3f ms, %zu binds issued per frame, %zu commands in %zu draw calls\n",
+                deferred_ms, deferred_binds.issued / FRAMES, statistics.commands, statistics.draw_calls);
+}
@@ -0,0 +1,107 @@
+#include "Benchmarks.hpp"
+
+#include <Core/DriveIO.hpp>
+
+#include <string>
+#include <future>
+#include <filesystem>
+
+void benchmark::RunDriveIO()
+{
+    constexpr size_t FILES = 5'000;
+    constexpr size_t FILE_SIZE = 4096;
+    constexpr int ITERATIONS = 3;
+
+    const auto directory = std::filesystem::temp_directory_path() / "gplot-benchmark-io";
+    std::error_code error;
+    std::filesystem::create_directories(directory, error);
+
+    gplot::core::DriveIO drive_io;
+
+    std::vector<std::string> paths(FILES);
+    {
+        std::vector<std::future<bool>> writes;
+        writes.reserve(FILES);
+        for (size_t i = 0; i < FILES; i++)
+        {
+            paths[i] = (directory / ("trace-" + std::to_string(i) + ".bin")).string();
+            writes.push_back(drive_io.WriteAsync(paths[i], gplot::core::DriveIO::file_data(FILE_SIZE, static_cast<char>(i))));
+        }
+
+        for (auto& write : writes)
+        {
+            if (!write.get())
+            {
+                return;
+            }
+        }
+    }
+
+    size_t bytes = 0;
+    const auto count = [&bytes](const std::vector<gplot::core::DriveIO::file_data>& files)
+    {
+        bytes = 0;
+        for (const auto& file : files)
+        {
+            bytes += file.size();
+        }
+    };
+
+    // One std::async thread per file, how ReadAsync used to work
+    const double async_ms = MeasureMs(ITERATIONS, [&]()
+    {
+        std::vector<std::future<gplot::core::DriveIO::file_data>> reads;
+        reads.reserve(FILES);
+        for (const auto& path : paths)
+        {
+            reads.push_back(std::async(std::launch::async, [&drive_io, &path]() { return drive_io.Read(path); }));
+        }
+
+        std::vector<gplot::core::DriveIO::file_data> files;
+        for (auto& read : reads)
+        {
+            files.push_back(read.get());
+        }
+        count(files);
+    });
+
+    const double futures_ms = MeasureMs(ITERATIONS, [&]()
+    {
+        std::vector<std::future<gplot::core::DriveIO::file_data>> reads;
+        reads.reserve(FILES);
+        for (const auto& path : paths)
+        {
+            reads.push_back(drive_io.ReadAsync(path));
+        }
+
+        std::vector<gplot::core::DriveIO::file_data> files;
+        for (auto& read : reads)
+        {
+            files.push_back(read.get());
+        }
+        count(files);
+    });
+
+    const double batch_ms = MeasureMs(ITERATIONS, [&]()
+    {
+        count(drive_io.ReadBatch(paths));
+    });
+
+    const double sequential_ms = MeasureMs(ITERATIONS, [&]()
+    {
+        std::vector<gplot::core::DriveIO::file_data> files;
+        for (const auto& path : paths)
+        {
+            files.push_back(drive_io.Read(path));
+        }
+        count(files);
+    });
+
+    std::printf("drive io: %zu files of %zu bytes, %zu I/O threads, %zu bytes read\n", FILES, FILE_SIZE, gplot::core::DriveIO::GetThreadCount(), bytes);
+    std::printf("  std::async per file    %10.3f ms\n", async_ms);
+    std::printf("  ReadAsync futures      %10.3f ms\n", futures_ms);
+    std::printf("  ReadBatch              %10.3f ms\n", batch_ms);
+    std::printf("  sequential Read        %10.3f ms\n", sequential_ms);
+
+    std::filesystem::remove_all(directory, error);
+}
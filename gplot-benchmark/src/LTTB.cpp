@@ -0,0 +1,52 @@
+#include "Benchmarks.hpp"
+
+#include <Plotting/Plotting.hpp>
+#include <Plotting/Decimation.hpp>
+
+#include <glad/glad.h>
+
+void benchmark::RunLTTB()
+{
+    constexpr size_t LINES = 8;
+    constexpr size_t POINTS = 250'000;
+    constexpr size_t TARGET = 2048;
+    constexpr int FRAMES = 5;
+
+    const auto lines = GenerateNoisySines(LINES, POINTS);
+    const std::vector<glm::vec4> colors(LINES, glm::vec4(1.0F, 0.0F, 0.0F, 1.0F));
+
+    std::vector<std::vector<gplot::core::Vertex>> reduced;
+    const double parallel_ms = MeasureMs(5, [&]() { reduced = gplot::DecimateLTTB(lines, TARGET); });
+
+    std::vector<gplot::core::Vertex> scratch;
+    const double serial_ms = MeasureMs(5, [&]()
+    {
+        for (const auto& line : lines)
+        {
+            gplot::DecimateLTTB(line, TARGET, scratch);
+        }
+    });
+
+    gplot::Plotter plotter;
+    const gplot::core::RectF bounds { { -1.0F, -1.0F }, { 1.0F, 1.0F } };
+
+    const double full_ms = MeasureMs(FRAMES, [&]()
+    {
+        glClear(GL_COLOR_BUFFER_BIT);
+        plotter.PlotLines(lines, colors, bounds, { }, 0.001F, 0.1F);
+        glFinish();
+    });
+
+    const double lttb_ms = MeasureMs(FRAMES, [&]()
+    {
+        glClear(GL_COLOR_BUFFER_BIT);
+        plotter.PlotLines(reduced, colors, bounds, { }, 0.001F, 0.1F);
+        glFinish();
+    });
+
+    std::printf("lttb: %zu lines x %zu points -> %zu points per line\n", LINES, POINTS, TARGET);
+    std::printf("  reduce, serial         %10.3f ms\n", serial_ms);
+    std::printf("  reduce, thread pool    %10.3f ms\n", parallel_ms);
+    std::printf("  frame, full resolution %10.3f ms\n", full_ms);
+    std::printf("  frame, lttb preview    %10.3f ms\n", lttb_ms);
+}
@@ -0,0 +1,56 @@
+#include "Benchmarks.hpp"
+
+#include <Plotting/Plotting.hpp>
+
+#include <utility>
+
+#include <glad/glad.h>
+
+void benchmark::RunLines()
+{
+    constexpr size_t LINES = 8;
+    constexpr size_t POINTS = 100'000;
+    constexpr int FRAMES = 5;
+
+    const auto lines = GenerateNoisySines(LINES, POINTS);
+    const std::vector<glm::vec4> colors(LINES, glm::vec4(1.0F, 0.0F, 0.0F, 1.0F));
+    const gplot::core::RectF bounds { { -1.0F, -1.0F }, { 1.0F, 1.0F } };
+
+    std::printf("lines: %zu lines x %zu points\n", LINES, POINTS);
+
+    constexpr std::pair<gplot::LinePipeline, const char*> PIPELINES[] =
+    {
+        { gplot::LinePipeline::eGeometryShader, "geometry shader" },
+        { gplot::LinePipeline::eInstanced, "instanced" },
+    };
+
+    for (const auto& [pipeline, name] : PIPELINES)
+    {
+        gplot::PlotterDescriptor descriptor;
+        descriptor.line_pipeline = pipeline;
+
+        gplot::Plotter plotter(descriptor);
+        plotter.SetCanvasSize(CANVAS_WIDTH, CANVAS_HEIGHT);
+
+        const double immediate_ms = MeasureMs(FRAMES, [&]()
+        {
+            glClear(GL_COLOR_BUFFER_BIT);
+            plotter.PlotLines(lines, colors, bounds, { }, 0.001F, 0.1F);
+            glFinish();
+        });
+
+        for (size_t l = 0; l < LINES; l++)
+        {
+            (void)plotter.AddSeries(lines[l], colors[l]);
+        }
+
+        const double retained_ms = MeasureMs(FRAMES, [&]()
+        {
+            glClear(GL_COLOR_BUFFER_BIT);
+            plotter.Render(bounds, { }, 0.001F, 0.1F);
+            glFinish();
+        });
+
+        std::printf("  %-16s immediate %10.3f ms, retained %10.3f ms\n", name, immediate_ms, retained_ms);
+    }
+}
@@ -0,0 +1,115 @@
+#include "Benchmarks.hpp"
+
+#include <Plotting/Plotting.hpp>
+
+#include <glad/glad.h>
+
+namespace
+{
+    // Row distance between the drawn line and the canvas center along the center column, negative if nothing was drawn
+    double MeasureLineOffset()
+    {
+        std::vector<std::uint8_t> column(4 * benchmark::CANVAS_HEIGHT);
+        glReadPixels(benchmark::CANVAS_WIDTH / 2, 0, 1, benchmark::CANVAS_HEIGHT, GL_RGBA, GL_UNSIGNED_BYTE, column.data());
+
+        double weight = 0.0;
+        double row = 0.0;
+        for (int y = 0; y < benchmark::CANVAS_HEIGHT; y++)
+        {
+            weight += column[4 * y];
+            row += column[4 * y] * (y + 0.5);
+        }
+
+        return weight > 0.0 ? std::abs(row / weight - benchmark::CANVAS_HEIGHT / 2.0) : -1.0;
+    }
+}
+
+void benchmark::RunPrecision()
+{
+    constexpr size_t POINTS = 1'000'000;
+    constexpr int FRAMES = 24;
+
+    // Ten years of nanosecond timestamps starting in 2023, zoomed down to a one second window
+    constexpr double START = 1.7e18;
+    constexpr double RANGE = 3.156e17;
+    constexpr double WINDOW = 1e9;
+    constexpr double STEP = RANGE / POINTS;
+
+    std::vector<glm::dvec2> points(POINTS);
+    for (size_t i = 0; i < POINTS; i++)
+    {
+        points[i] = { START + STEP * static_cast<double>(i), std::sin(static_cast<double>(i) * 0.37) * 0.8 };
+    }
+
+    // The window sits between two samples, its center is on the line they span
+    const size_t sample = POINTS / 2 + 7;
+    const glm::dvec2 center = (points[sample] + points[sample + 1]) / 2.0;
+    const double slope = (points[sample + 1].y - points[sample].y) / STEP;
+    const glm::dvec2 final_proportions { WINDOW, std::abs(slope) * WINDOW * 2.0 };
+
+    const gplot::core::RectF bounds { { 0.0F, 0.0F }, { 1.0F, 1.0F } };
+
+    std::printf("precision: %zu points over %.3g ns, zooming into a %.3g ns window\n", POINTS, RANGE, WINDOW);
+
+    struct Mode
+    {
+        bool precise;
+        gplot::ChunkEncoding encoding;
+        const char* name;
+    };
+
+    constexpr Mode MODES[] =
+    {
+        { false, gplot::ChunkEncoding::eFloat32, "float" },
+        { true, gplot::ChunkEncoding::eFloat32, "precise" },
+        { true, gplot::ChunkEncoding::eUNorm16, "quantized" },
+    };
+
+    for (const auto& [precise, encoding, name] : MODES)
+    {
+        gplot::PlotterDescriptor descriptor;
+        descriptor.chunk_encoding = encoding;
+
+        gplot::Plotter plotter(descriptor);
+        plotter.SetCanvasSize(CANVAS_WIDTH, CANVAS_HEIGHT);
+
+        if (precise)
+        {
+            (void)plotter.AddPreciseSeries(points, glm::vec4(1.0F, 0.0F, 0.0F, 1.0F));
+        }
+        else
+        {
+            std::vector<gplot::core::Vertex> vertices(POINTS);
+            for (size_t i = 0; i < POINTS; i++)
+            {
+                vertices[i].pos = glm::vec2(points[i]);
+            }
+            (void)plotter.AddSeries(std::move(vertices), glm::vec4(1.0F, 0.0F, 0.0F, 1.0F));
+        }
+
+        gplot::CameraViewport camera;
+        camera.center = center;
+
+        // Geometric zoom from the whole range to the window, the last frame stays on the window
+        int frame = 0;
+        const double zoom_ms = MeasureMs(FRAMES, [&]()
+        {
+            const double t = static_cast<double>(frame++) / (FRAMES - 1);
+            camera.proportions = glm::dvec2(RANGE, 2.0) * glm::pow(final_proportions / glm::dvec2(RANGE, 2.0), glm::dvec2(t));
+
+            glClear(GL_COLOR_BUFFER_BIT);
+            plotter.Render(bounds, camera, static_cast<float>(camera.proportions.y * 0.005), 0.3F);
+            glFinish();
+        });
+
+        const double offset = MeasureLineOffset();
+        if (offset < 0.0)
+        {
+            std::printf("  %-10s zoom %10.3f ms, line missing from the window\n", name, zoom_ms);
+        }
+        else
+        {
+            std::printf("  %-10s zoom %10.3f ms, line off by %8.2f px\n", name, zoom_ms, offset);
+        }
+    }
+}
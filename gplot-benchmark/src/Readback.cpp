@@ -0,0 +1,58 @@
+#include "Benchmarks.hpp"
+
+#include <Core/Image.hpp>
+#include <Plotting/Plotting.hpp>
+#include <Graphics/ReadbackQueue.hpp>
+#include <Graphics/OffscreenCanvas.hpp>
+
+#include <atomic>
+
+#include <glad/glad.h>
+
+void benchmark::RunReadback()
+{
+    constexpr size_t LINES = 4;
+    constexpr size_t POINTS = 2'000;
+    constexpr int FRAMES = 30;
+
+    const auto lines = GenerateNoisySines(LINES, POINTS);
+    const std::vector<glm::vec4> colors(LINES, glm::vec4(1.0F, 0.0F, 0.0F, 1.0F));
+    const gplot::core::RectF bounds { { -1.0F, -1.0F }, { 1.0F, 1.0F } };
+
+    gplot::graphics::OffscreenCanvas canvas({ CANVAS_WIDTH, CANVAS_HEIGHT });
+    gplot::Plotter plotter;
+
+    std::atomic<size_t> encoded_bytes = 0;
+    const auto render = [&]()
+    {
+        canvas.Bind();
+        glClear(GL_COLOR_BUFFER_BIT);
+        plotter.PlotLines(lines, colors, bounds, { }, 0.001F, 0.1F);
+    };
+
+    std::vector<std::uint8_t> pixels;
+    const double sync_ms = MeasureMs(FRAMES, [&]()
+    {
+        render();
+        canvas.ReadPixels(pixels);
+        encoded_bytes += gplot::core::EncodePNG(pixels.data(), CANVAS_WIDTH, CANVAS_HEIGHT).size();
+    });
+
+    gplot::graphics::ReadbackQueue queue({ CANVAS_WIDTH, CANVAS_HEIGHT });
+    const double async_ms = MeasureMs(FRAMES, [&]()
+    {
+        render();
+        queue.Capture(canvas.GetFramebuffer(), [&](std::vector<std::uint8_t> frame, gplot::graphics::Texture::texsize size, std::uint64_t)
+        {
+            encoded_bytes += gplot::core::EncodePNG(frame.data(), size.x, size.y).size();
+        });
+        queue.Poll();
+    });
+
+    const double flush_ms = MeasureMs(1, [&]() { queue.Flush(); });
+
+    std::printf("readback: %dx%d, %d frames, %zu bytes encoded\n", CANVAS_WIDTH, CANVAS_HEIGHT, FRAMES, encoded_bytes.load());
+    std::printf("  frame, glReadPixels + encode %10.3f ms\n", sync_ms);
+    std::printf("  frame, readback queue        %10.3f ms\n", async_ms);
+    std::printf("  queue flush at the end       %10.3f ms\n", flush_ms);
+}
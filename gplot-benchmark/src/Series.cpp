@@ -0,0 +1,72 @@
+#include "Benchmarks.hpp"
+
+#include <Plotting/Plotting.hpp>
+
+#include <utility>
+
+#include <glad/glad.h>
+
+void benchmark::RunSeries()
+{
+    constexpr size_t SERIES = 20'000;
+    constexpr size_t POINTS = 32;
+    constexpr int FRAMES = 20;
+
+    const auto lines = GenerateNoisySines(SERIES, POINTS);
+    const gplot::core::RectF bounds { { -1.0F, -1.0F }, { 1.0F, 1.0F } };
+
+    std::printf("series: %zu series x %zu points\n", SERIES, POINTS);
+
+    // A tiny viewport keeps the measurement on submission cost rather than rasterization
+    glViewport(0, 0, 16, 16);
+
+    constexpr std::pair<bool, const char*> MODES[] =
+    {
+        { false, "multi draw" },
+        { true, "indirect" },
+    };
+
+    for (const auto& [indirect, name] : MODES)
+    {
+        gplot::PlotterDescriptor descriptor;
+        descriptor.indirect_draws = indirect;
+
+        gplot::Plotter plotter(descriptor);
+        plotter.SetCanvasSize(CANVAS_WIDTH, CANVAS_HEIGHT);
+
+        std::vector<gplot::SeriesHandle> handles;
+        for (const auto& line : lines)
+        {
+            handles.push_back(plotter.AddSeries(line, glm::vec4(0.0F, 1.0F, 0.0F, 0.2F)));
+        }
+
+        plotter.Render(bounds, { }, 0.001F, 0.1F);
+        glFinish();
+
+        const double render_ms = MeasureMs(FRAMES, [&]()
+        {
+            glClear(GL_COLOR_BUFFER_BIT);
+            plotter.Render(bounds, { }, 0.001F, 0.1F);
+            glFinish();
+        });
+
+        // Every frame hides a different tenth of the series
+        int frame = 0;
+        const double toggle_ms = MeasureMs(FRAMES, [&]()
+        {
+            for (size_t i = 0; i < handles.size(); i++)
+            {
+                plotter.SetSeriesVisible(handles[i], (i + frame) % 10 != 0);
+            }
+            frame++;
+
+            glClear(GL_COLOR_BUFFER_BIT);
+            plotter.Render(bounds, { }, 0.001F, 0.1F);
+            glFinish();
+        });
+
+        std::printf("  %-16s render %10.3f ms, toggling visibility %10.3f ms\n", name, render_ms, toggle_ms);
+    }
+
+    glViewport(0, 0, CANVAS_WIDTH, CANVAS_HEIGHT);
+}
@@ -0,0 +1,87 @@
+#include "Benchmarks.hpp"
+
+#include <Graphics/FBO.hpp>
+#include <Graphics/Texture.hpp>
+
+#include <SDL.h>
+#include <SDL_main.h>
+#include <glad/glad.h>
+
+#include <string_view>
+
+namespace
+{
+    struct BenchmarkEntry
+    {
+        std::string_view name;
+        void (*run)();
+    };
+
+    constexpr BenchmarkEntry BENCHMARKS[] =
+    {
+        { "lttb", benchmark::RunLTTB },
+        { "lines", benchmark::RunLines },
+        { "readback", benchmark::RunReadback },
+        { "dashboard", benchmark::RunDashboard },
+        { "series", benchmark::RunSeries },
+        { "precision", benchmark::RunPrecision },
+        { "bounds", benchmark::RunBounds },
+        { "columnar", benchmark::RunColumnar },
+        { "csv", benchmark::RunCsv },
+        { "io", benchmark::RunDriveIO },
+    };
+}
+
+int main(int argc, char* argv[])
+{
+    SDL_Init(SDL_INIT_VIDEO);
+    SDL_GL_SetAttribute(SDL_GL_CONTEXT_PROFILE_MASK, SDL_GL_CONTEXT_PROFILE_CORE);
+    SDL_GL_SetAttribute(SDL_GL_CONTEXT_MAJOR_VERSION, 3);
+    SDL_GL_SetAttribute(SDL_GL_CONTEXT_MINOR_VERSION, 3);
+
+    // Benchmarks render offscreen, the window only provides the context
+    const auto window = SDL_CreateWindow("gplot-benchmark", SDL_WINDOWPOS_UNDEFINED, SDL_WINDOWPOS_UNDEFINED, 16, 16, SDL_WINDOW_HIDDEN | SDL_WINDOW_OPENGL);
+    const auto context = SDL_GL_CreateContext(window);
+    if (!window || !context)
+    {
+        std::fprintf(stderr, "Failed to create an OpenGL context: %s\n", SDL_GetError());
+        return 1;
+    }
+
+    gladLoadGLLoader(SDL_GL_GetProcAddress);
+    std::printf("renderer: %s, %s\n", glGetString(GL_RENDERER), glGetString(GL_VERSION));
+
+    // GL objects have to be released while the context is still alive
+    {
+        gplot::graphics::FBO framebuffer;
+        gplot::graphics::Texture canvas({ benchmark::CANVAS_WIDTH, benchmark::CANVAS_HEIGHT });
+        framebuffer.SetTexture(canvas.GetTextureId());
+
+        framebuffer.Bind();
+        glViewport(0, 0, benchmark::CANVAS_WIDTH, benchmark::CANVAS_HEIGHT);
+
+        glEnable(GL_BLEND);
+        glBlendFuncSeparate(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA, GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
+
+        // Without arguments every benchmark runs, otherwise only the named ones
+        for (const auto& benchmark : BENCHMARKS)
+        {
+            bool selected = argc < 2;
+            for (int i = 1; i < argc; i++)
+            {
+                selected |= benchmark.name == argv[i];
+            }
+
+            if (selected)
+            {
+                benchmark.run();
+            }
+        }
+    }
+
+    SDL_GL_DeleteContext(context);
+    SDL_DestroyWindow(window);
+    SDL_Quit();
+
+    return 0;
+}
@@ -0,0 +1,95 @@
+#pragma once
+
+#include <span>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <optional>
+#include <string_view>
+
+#include <Core/Math.hpp>
+#include <Core/MappedFile.hpp>
+
+namespace gplot::core
+{
+    enum class ColumnType : std::uint32_t
+    {
+        eFloat32 = 1,
+        eFloat64 = 2,
+        eInt64 = 3,
+        eVertex = 4, // interleaved float x, y pairs, laid out as gplot::core::Vertex
+    };
+
+    // gplot columnar file, little endian: a file header, one header per column with its type, length and
+    // finite range, then the column blocks. Every block starts on a COLUMN_ALIGNMENT boundary, so the views
+    // handed out are aligned and reading part of a column only faults in the pages of that part.
+    class ColumnarFile
+    {
+    public:
+
+        static constexpr size_t COLUMN_ALIGNMENT = 4096;
+        static constexpr size_t MAX_NAME_LENGTH = 31;
+
+        struct Column
+        {
+            std::string name;
+            ColumnType type { ColumnType::eFloat32 };
+
+            // Elements, a vertex counts once
+            size_t length { 0 };
+            size_t nan_count { 0 };
+
+            // Finite range per component, y is only used by eVertex columns
+            glm::dvec2 min { std::numeric_limits<double>::max() };
+            glm::dvec2 max { std::numeric_limits<double>::lowest() };
+
+            size_t offset { 0 };
+        };
+
+        struct ColumnSource
+        {
+            std::string_view name;
+            ColumnType type { ColumnType::eFloat32 };
+            std::span<const std::byte> data;
+        };
+
+    public:
+
+        // Maps the file and validates its headers, the column data is not read
+        explicit ColumnarFile(std::string_view path);
+
+        ColumnarFile(ColumnarFile&& ) = delete;
+        ColumnarFile(const ColumnarFile& ) = delete;
+        ColumnarFile& operator=(ColumnarFile&&) = delete;
+        ColumnarFile& operator=(const ColumnarFile&) = delete;
+
+        // Scans every column for its range while writing. Names longer than MAX_NAME_LENGTH are cut.
+        static bool Write(std::string_view path, std::span<const ColumnSource> columns);
+
+        [[nodiscard]] const std::vector<Column>& GetColumns() const noexcept;
+
+        [[nodiscard]] std::optional<size_t> FindColumn(std::string_view name) const;
+
+        // Views into the mapping, empty when the column holds another type
+        [[nodiscard]] std::span<const float> GetFloat32(size_t column) const;
+
+        [[nodiscard]] std::span<const double> GetFloat64(size_t column) const;
+
+        [[nodiscard]] std::span<const std::int64_t> GetInt64(size_t column) const;
+
+        [[nodiscard]] std::span<const Vertex> GetVertices(size_t column) const;
+
+        // Hints that elements [first, first + count) of a column, e.g. the visible range, are read soon
+        void Prefetch(size_t column, size_t first, size_t count) const;
+
+    private:
+
+        [[nodiscard]] std::span<const std::byte> GetColumnData(size_t column, ColumnType type) const;
+
+    private:
+
+        MappedFile m_file;
+        std::vector<Column> m_columns;
+
+    };
+}
@@ -0,0 +1,7 @@
+#pragma once
+
+namespace gplot::core
+{
+    // Runtime checks for kernels compiled past the target's baseline instruction set, false on other architectures
+    [[nodiscard]] bool IsAVX2Supported();
+}
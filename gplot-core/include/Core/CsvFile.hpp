@@ -0,0 +1,77 @@
+#pragma once
+
+#include <span>
+#include <string>
+#include <vector>
+#include <optional>
+#include <string_view>
+
+#include <Core/Math.hpp>
+
+namespace gplot::core
+{
+    struct CsvFileDescriptor
+    {
+        // ',' for CSV, '\t' for TSV
+        char delimiter { ',' };
+
+        // Without a header the columns are named by their index and counted from the first row
+        bool has_header { true };
+
+        // Bytes per parallel parse task, task boundaries are moved forward to the next newline
+        size_t chunk_size { 1 << 22 };
+    };
+
+    // Numeric delimited text loaded into one float array per column. The file is memory mapped and split into
+    // newline aligned chunks parsed on the default thread pool. Quoted fields may not contain delimiters or
+    // newlines. Empty or malformed cells and the cells missing from short rows are read as NaN, fields past
+    // the last column are ignored.
+    class CsvFile
+    {
+    public:
+
+        struct Column
+        {
+            std::string name;
+            std::vector<float> values;
+
+            // Cells that were read as NaN because they did not hold a number
+            size_t invalid_count { 0 };
+        };
+
+    public:
+
+        // Throws when the file cannot be mapped or has no columns
+        explicit CsvFile(std::string_view path, const CsvFileDescriptor& descriptor = { });
+
+        CsvFile(CsvFile&& ) = delete;
+        CsvFile(const CsvFile& ) = delete;
+        CsvFile& operator=(CsvFile&&) = delete;
+        CsvFile& operator=(const CsvFile&) = delete;
+
+        [[nodiscard]] const std::vector<Column>& GetColumns() const noexcept;
+
+        [[nodiscard]] size_t GetRowCount() const noexcept;
+
+        [[nodiscard]] std::optional<size_t> FindColumn(std::string_view name) const;
+
+        // Empty for an unknown column
+        [[nodiscard]] std::span<const float> GetValues(size_t column) const;
+
+        // Pairs two columns into vertices for Plotter::AddSeries, empty for an unknown column
+        [[nodiscard]] std::vector<Vertex> GetVertices(size_t x_column, size_t y_column) const;
+
+        // Instruction set used to find delimiters and newlines: "avx2", "sse2", "neon" or "scalar"
+        [[nodiscard]] static const char* GetDelimiterKernelName();
+
+    private:
+
+        void Parse(std::string_view text, const CsvFileDescriptor& descriptor);
+
+    private:
+
+        std::vector<Column> m_columns;
+        size_t m_row_count { 0 };
+
+    };
+}
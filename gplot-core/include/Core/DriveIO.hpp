@@ -1,29 +1,58 @@
 #pragma once
 
+#include <string>
 #include <vector>
 #include <future>
+#include <functional>
+#include <string_view>
 
 namespace gplot::core
 {
+    class ThreadPool;
+
+    // Whole-file reads and writes. Read data is terminated with '\0' that is part of the returned size.
+    // Asynchronous requests run on a small I/O pool shared by every DriveIO, so many requests queue
+    // instead of starting a thread each. Paths are copied, buffers are moved in and out.
     class DriveIO
     {
     public:
 
         using file_data = std::vector<char>;
 
+        // Completion callbacks run on an I/O thread and must not throw, `data` is empty and `written` false on failure
+        using ReadCallback = std::function<void(file_data data)>;
+        using BatchReadCallback = std::function<void(size_t index, file_data data)>;
+        using WriteCallback = std::function<void(bool written)>;
+
+        // Blocking, run on the calling thread
         file_data Read(std::string_view path);
 
         bool Write(std::string_view path, const file_data& data);
 
         std::future<file_data> ReadAsync(std::string_view path);
 
-        std::future<bool> WriteAsync(std::string_view path, const file_data& data);
+        void ReadAsync(std::string_view path, ReadCallback on_read);
+
+        std::future<bool> WriteAsync(std::string_view path, file_data data);
+
+        void WriteAsync(std::string_view path, file_data data, WriteCallback on_written);
+
+        // Reads every file on the I/O pool, the results keep the order of `paths`. Blocks, so it must not be
+        // called from a completion callback.
+        std::vector<file_data> ReadBatch(std::vector<std::string> paths);
+
+        // Calls `on_read` with the index of each file as soon as it is read, the future is ready after the last call
+        std::future<void> ReadBatchAsync(std::vector<std::string> paths, BatchReadCallback on_read);
+
+        [[nodiscard]] static size_t GetThreadCount();
 
     private:
 
+        [[nodiscard]] static ThreadPool& GetPool();
+
         static file_data ReadFile(std::string_view path);
 
         static bool WriteFile(std::string_view path, const file_data& data);
 
     };
-}
\ No newline at end of file
+}
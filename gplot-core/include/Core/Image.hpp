@@ -0,0 +1,17 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include <string_view>
+
+namespace gplot::core
+{
+    // 8-bit RGBA PNG, rows top to bottom. Deflate goes through zlib when gplot-core was built with it,
+    // otherwise the image data is stored uncompressed.
+    [[nodiscard]] std::vector<std::uint8_t> EncodePNG(const std::uint8_t* rgba, int width, int height);
+
+    bool WritePNG(std::string_view path, const std::uint8_t* rgba, int width, int height);
+
+    // OpenGL reads rows bottom to top, images store them top to bottom
+    void FlipRows(std::uint8_t* pixels, size_t row_size, int height);
+}
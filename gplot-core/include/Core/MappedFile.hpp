@@ -0,0 +1,41 @@
+#pragma once
+
+#include <span>
+#include <cstddef>
+#include <string_view>
+
+namespace gplot::core
+{
+    // Read-only memory map of a whole file. Pages are only read from disk when they are first touched.
+    class MappedFile
+    {
+    public:
+
+        explicit MappedFile(std::string_view path);
+
+        ~MappedFile() noexcept;
+
+        MappedFile(MappedFile&& ) = delete;
+        MappedFile(const MappedFile& ) = delete;
+        MappedFile& operator=(MappedFile&&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+
+        [[nodiscard]] std::span<const std::byte> GetData() const noexcept;
+
+        [[nodiscard]] size_t GetSize() const noexcept;
+
+        // Hints that [offset, offset + size) is read soon, so the OS can fetch it ahead of the first access
+        void Prefetch(size_t offset, size_t size) const;
+
+    private:
+
+        const std::byte* m_data { nullptr };
+        size_t m_size { 0 };
+
+#if defined(_WIN32)
+        void* m_file { nullptr };
+        void* m_mapping { nullptr };
+#endif
+
+    };
+}
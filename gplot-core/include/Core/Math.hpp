@@ -1,5 +1,10 @@
 #pragma once
 
+#include <span>
+#include <limits>
+#include <cstddef>
+#include <cstdint>
+
 #include <glm/glm.hpp>
 
 namespace gplot::core
@@ -9,8 +14,11 @@ namespace gplot::core
     {
         glm::vec<2, T> min { std::numeric_limits<T>::max() };
         glm::vec<2, T> max { std::numeric_limits<T>::lowest() };
+
+        bool operator==(const Rect&) const = default;
     };
     using RectF = Rect<float>;
+    using RectD = Rect<double>;
 
     struct Color
     {
@@ -21,5 +29,31 @@ namespace gplot::core
     {
         glm::vec2 pos { 0.0F };
     };
-}
 
+    // NaNs are skipped by both rects, infinities only widen `bounds`. Axes without values keep the empty Rect defaults.
+    struct DataRange
+    {
+        RectF bounds;
+        RectF finite;
+
+        // Vertices with at least one NaN coordinate
+        size_t nan_count { 0 };
+    };
+
+    struct ValueRange
+    {
+        float min { std::numeric_limits<float>::max() };
+        float max { std::numeric_limits<float>::lowest() };
+        float finite_min { std::numeric_limits<float>::max() };
+        float finite_max { std::numeric_limits<float>::lowest() };
+        size_t nan_count { 0 };
+    };
+
+    // Vectorized with the widest kernel the CPU supports, large arrays are split over the default thread pool
+    [[nodiscard]] DataRange ScanDataRange(std::span<const Vertex> vertices);
+
+    [[nodiscard]] ValueRange ScanValueRange(std::span<const float> values);
+
+    // Kernel picked at runtime: "avx2", "sse2", "neon" or "scalar"
+    [[nodiscard]] const char* GetScanKernelName();
+}
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <queue>
+#include <mutex>
+#include <memory>
+#include <thread>
+#include <vector>
+#include <future>
+#include <functional>
+#include <condition_variable>
+
+namespace gplot::core
+{
+    class ThreadPool
+    {
+    public:
+
+        explicit ThreadPool(size_t thread_count = std::thread::hardware_concurrency());
+
+        ~ThreadPool() noexcept;
+
+        ThreadPool(ThreadPool&& ) = delete;
+        ThreadPool(const ThreadPool& ) = delete;
+        ThreadPool& operator=(ThreadPool&&) = delete;
+        ThreadPool& operator=(const ThreadPool&) = delete;
+
+        template<typename F>
+        auto Submit(F&& task) -> std::future<std::invoke_result_t<std::decay_t<F>>>
+        {
+            using result_t = std::invoke_result_t<std::decay_t<F>>;
+
+            auto packaged = std::make_shared<std::packaged_task<result_t()>>(std::forward<F>(task));
+            auto future = packaged->get_future();
+
+            Enqueue([packaged]() { (*packaged)(); });
+            return future;
+        }
+
+        // Splits [0, count) into chunks of at least `grain` elements and runs them on the pool and the calling thread.
+        // The caller claims chunks as well, so nested calls from a worker cannot starve.
+        void ParallelFor(size_t count, size_t grain, const std::function<void(size_t begin, size_t end)>& task);
+
+        [[nodiscard]] size_t GetThreadCount() const noexcept;
+
+        [[nodiscard]] static ThreadPool& GetDefault();
+
+    private:
+
+        void Enqueue(std::function<void()> task);
+
+        void WorkerLoop();
+
+    private:
+
+        std::vector<std::thread> m_workers;
+
+        std::queue<std::function<void()>> m_tasks;
+        std::mutex m_mutex;
+        std::condition_variable m_condition;
+        bool m_stop { false };
+
+    };
+}
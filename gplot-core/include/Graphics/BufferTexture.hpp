@@ -0,0 +1,33 @@
+#pragma once
+
+#include <glad/glad.h>
+
+namespace gplot::graphics
+{
+    // Texel view over a buffer object, lets shaders fetch vertex data directly through texelFetch
+    class BufferTexture
+    {
+    public:
+
+        BufferTexture() noexcept;
+
+        ~BufferTexture() noexcept;
+
+        BufferTexture(BufferTexture&& other) = delete;
+        BufferTexture(const BufferTexture& other) = delete;
+        BufferTexture& operator=(BufferTexture&&) = delete;
+        BufferTexture& operator=(const BufferTexture&) = delete;
+
+        void Attach(GLuint buffer, GLenum format) const;
+
+        void Bind(int unit) const;
+
+        [[nodiscard]] static GLint GetMaxTexels();
+
+        [[nodiscard]] GLuint GetTextureId() const noexcept;
+
+    private:
+
+        GLuint m_texture { 0 };
+    };
+}
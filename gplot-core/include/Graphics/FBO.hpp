@@ -14,10 +14,13 @@ namespace gplot::graphics
 
         void Bind() const;
 
+        // Leaves the framebuffer bound
         void SetTexture(GLuint texture);
 
         [[nodiscard]] GLuint GetColorTexture() const noexcept;
 
+        [[nodiscard]] GLuint GetId() const noexcept;
+
         static void Reset() noexcept;
 
         static void SetDefaultFramebuffer(GLuint fbo);
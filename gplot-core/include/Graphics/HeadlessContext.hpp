@@ -0,0 +1,31 @@
+#pragma once
+
+namespace gplot::graphics
+{
+    // Window-less OpenGL 3.3 core context on an EGL surfaceless display, e.g. Mesa's llvmpipe on GPU-less servers.
+    // Rendering has to go into an FBO, see OffscreenCanvas.
+    class HeadlessContext
+    {
+    public:
+
+        HeadlessContext();
+
+        ~HeadlessContext() noexcept;
+
+        HeadlessContext(HeadlessContext&& other) = delete;
+        HeadlessContext(const HeadlessContext& other) = delete;
+        HeadlessContext& operator=(HeadlessContext&&) = delete;
+        HeadlessContext& operator=(const HeadlessContext&) = delete;
+
+        void MakeCurrent() const;
+
+        // False when gplot-core was built without EGL
+        [[nodiscard]] static bool IsSupported() noexcept;
+
+    private:
+
+        void* m_display { nullptr };
+        void* m_context { nullptr };
+
+    };
+}
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <glad/glad.h>
+
+#include <span>
+#include <cstddef>
+
+namespace gplot::graphics
+{
+    // GL_DRAW_INDIRECT_BUFFER of glMultiDrawArraysIndirect commands, kept on the GPU between frames
+    class IndirectBuffer
+    {
+    public:
+
+        // Layout mandated by glMultiDrawArraysIndirect
+        struct DrawArraysCommand
+        {
+            GLuint count { 0 };
+            GLuint instance_count { 0 };
+            GLuint first { 0 };
+            GLuint base_instance { 0 };
+        };
+
+    public:
+
+        IndirectBuffer() noexcept;
+
+        ~IndirectBuffer() noexcept;
+
+        IndirectBuffer(IndirectBuffer&& other) = delete;
+        IndirectBuffer(const IndirectBuffer& other) = delete;
+        IndirectBuffer& operator=(IndirectBuffer&&) = delete;
+        IndirectBuffer& operator=(const IndirectBuffer&) = delete;
+
+        // Replaces every command, the storage only grows
+        void Update(std::span<const DrawArraysCommand> commands);
+
+        // Patches a single command in place, a zero instance count skips it without touching the others
+        void SetInstanceCount(size_t index, GLuint instance_count) const;
+
+        void Bind() const;
+
+        [[nodiscard]] size_t GetCommandCount() const noexcept;
+
+        [[nodiscard]] static bool IsSupported();
+
+    private:
+
+        GLuint m_id { 0 };
+        size_t m_count { 0 };
+        size_t m_capacity { 0 };
+    };
+}
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <Graphics/FBO.hpp>
+#include <Graphics/Texture.hpp>
+
+#include <vector>
+#include <cstdint>
+
+namespace gplot::graphics
+{
+    // RGBA8 color target for rendering without a window
+    class OffscreenCanvas
+    {
+    public:
+
+        explicit OffscreenCanvas(Texture::texsize size);
+
+        OffscreenCanvas(OffscreenCanvas&& other) = delete;
+        OffscreenCanvas(const OffscreenCanvas& other) = delete;
+        OffscreenCanvas& operator=(OffscreenCanvas&&) = delete;
+        OffscreenCanvas& operator=(const OffscreenCanvas&) = delete;
+
+        // Binds the framebuffer and covers it with the viewport
+        void Bind() const;
+
+        // Rows are returned top to bottom, the way images are stored
+        void ReadPixels(std::vector<std::uint8_t>& pixels) const;
+
+        [[nodiscard]] Texture::texsize GetSize() const;
+
+        [[nodiscard]] const FBO& GetFramebuffer() const noexcept;
+
+        [[nodiscard]] const Texture& GetTexture() const noexcept;
+
+    private:
+
+        Texture m_texture;
+        FBO m_framebuffer;
+
+    };
+}
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <Core/ThreadPool.hpp>
+#include <Graphics/FBO.hpp>
+#include <Graphics/Texture.hpp>
+
+#include <vector>
+#include <future>
+#include <cstdint>
+#include <functional>
+
+namespace gplot::graphics
+{
+    // Asynchronous framebuffer readback through a ring of fenced pixel-pack buffers. A capture only queues the copy,
+    // its pixels are collected by a later Poll once the GPU is done, typically `depth - 1` frames later.
+    // Callbacks run on the thread pool, so encoding does not block the render thread.
+    class ReadbackQueue
+    {
+    public:
+
+        // RGBA8 pixels with rows top to bottom, the frame is the capture index
+        using Callback = std::function<void(std::vector<std::uint8_t> pixels, Texture::texsize size, std::uint64_t frame)>;
+
+    public:
+
+        explicit ReadbackQueue(Texture::texsize size, size_t depth = 3, gplot::core::ThreadPool& pool = gplot::core::ThreadPool::GetDefault());
+
+        ~ReadbackQueue() noexcept;
+
+        ReadbackQueue(ReadbackQueue&& other) = delete;
+        ReadbackQueue(const ReadbackQueue& other) = delete;
+        ReadbackQueue& operator=(ReadbackQueue&&) = delete;
+        ReadbackQueue& operator=(const ReadbackQueue&) = delete;
+
+        // Queues a copy of the color attachment, blocks only when all buffers are still in flight.
+        // Leaves the framebuffer bound for reading.
+        void Capture(const FBO& framebuffer, Callback on_ready);
+
+        // Hands every finished copy over to the thread pool without waiting for the GPU
+        void Poll();
+
+        // Waits for all queued captures and their callbacks
+        void Flush();
+
+        [[nodiscard]] size_t GetPendingCount() const noexcept;
+
+    private:
+
+        struct Slot
+        {
+            GLuint buffer { 0 };
+            GLsync fence { nullptr };
+            Callback callback;
+            std::uint64_t frame { 0 };
+        };
+
+        void Collect(Slot& slot, bool wait);
+
+        [[nodiscard]] Slot& GetOldest();
+
+    private:
+
+        Texture::texsize m_size;
+        gplot::core::ThreadPool& m_pool;
+
+        std::vector<Slot> m_slots;
+        size_t m_head { 0 };
+        size_t m_pending { 0 };
+        std::uint64_t m_frame { 0 };
+
+        std::vector<std::future<void>> m_callbacks;
+
+    };
+}
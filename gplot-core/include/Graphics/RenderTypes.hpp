@@ -1,5 +1,10 @@
 #pragma once
 
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+
+#include <cstdint>
+
 namespace gplot::graphics
 {
     enum class Primitive
@@ -7,5 +12,29 @@ namespace gplot::graphics
         eLines,
         eLinesStrip,
         eLinesStripAdjacent,
+        eTriangleStrip,
+    };
+
+    enum class BlendMode
+    {
+        eInherit,   // leaves the blending state of the context untouched
+        eOpaque,
+        eAlpha,
+    };
+
+    // Layers of one target are drawn in order, commands inside a layer are reordered to minimize state changes
+    enum class RenderLayer : std::uint8_t
+    {
+        eGrid,
+        eSeries,
+        eMarkers,
+    };
+
+    struct RenderTarget
+    {
+        GLuint framebuffer { 0 };
+        glm::ivec4 viewport { 0 }; // x, y, width, height, an empty viewport covers the window canvas
+
+        bool operator==(const RenderTarget&) const = default;
     };
-}
\ No newline at end of file
+}
@@ -3,20 +3,176 @@
 #include <Graphics/Shader.hpp>
 #include <Graphics/RenderTypes.hpp>
 #include <Graphics/VertexBuffer.hpp>
+#include <Graphics/IndirectBuffer.hpp>
+#include <Graphics/BufferTexture.hpp>
+#include <Graphics/UniformBuffer.hpp>
+
+#include <span>
+#include <array>
+#include <memory>
+#include <vector>
+#include <optional>
+#include <unordered_map>
 
 namespace gplot::graphics
 {
+    // Deferred command list. Draws are recorded with the current target and state, RenderCurrent sorts them by
+    // target, layer, program, blend state, VAO and uniform block, then submits them with the fewest state changes,
+    // merging compatible multi-draws into a single call. Programs and VAOs are ordered by their first use in the
+    // frame, so the result does not depend on where objects live in memory.
     class Renderer
     {
     public:
 
+        // Buffer texture attached and bound right before a command is drawn
+        struct TexelBinding
+        {
+            const BufferTexture* texture { nullptr };
+            GLuint buffer { 0 };
+            GLenum format { 0 };
+            GLuint unit { 0 };
+
+            bool operator==(const TexelBinding&) const = default;
+        };
+
+        struct TextureBinding
+        {
+            GLenum target { 0 };
+            GLuint texture { 0 };
+            GLuint unit { 0 };
+
+            bool operator==(const TextureBinding&) const = default;
+        };
+
+        struct RenderState
+        {
+            const Shader* shader { nullptr };
+            RenderLayer layer { RenderLayer::eSeries };
+            BlendMode blend { BlendMode::eInherit };
+            std::array<TexelBinding, 2> texel_buffers { };
+            std::array<TextureBinding, 1> textures { };
+
+            // The shader pulls its vertices from `texel_buffers`, the buffer's per-vertex arrays stay disabled
+            bool vertex_pulling { false };
+        };
+
+        // Uniform block binding points the renderer tracks per command
+        static constexpr GLuint UNIFORM_BLOCK_BINDINGS = 4;
+
+        struct Statistics
+        {
+            size_t commands { 0 };
+            size_t draw_calls { 0 };
+            size_t merged { 0 };
+        };
+
+    public:
+
+        Renderer();
+
+        Renderer(Renderer&& other) = delete;
+        Renderer(const Renderer& other) = delete;
+        Renderer& operator=(Renderer&&) = delete;
+        Renderer& operator=(const Renderer&) = delete;
+
+        // Drops the recorded commands and resets the current target, state and uniform block
         void PrepareFrame();
 
         void RenderCurrent();
 
+        // Viewport used by targets with an empty viewport
         void ResizeWindowCanvas(int width, int height);
 
-        void RenderMultiBuffer(Primitive primitive, VertexBuffer& buffer, const std::vector<size_t>& offsets, const std::vector<size_t>& sizes, size_t count);
+        // Commands recorded afterwards draw into this target, std::nullopt keeps whatever is bound at submission
+        void SetTarget(std::optional<RenderTarget> target);
+
+        void SetState(const RenderState& state);
+
+        // Copies a uniform block for the commands recorded afterwards, all blocks of a frame are uploaded with one write.
+        // Each binding point keeps its own current block.
+        void SetUniformBlock(GLuint binding, const void* data, size_t size);
+
+        void RenderMultiBuffer(Primitive primitive, const VertexBuffer& buffer, std::span<const GLint> offsets, std::span<const GLsizei> sizes);
+
+        // One instanced draw of `instance_vertices` vertices per range, starting at the range offset
+        void RenderInstancedRanges(Primitive primitive, const VertexBuffer& buffer, GLsizei instance_vertices, std::span<const GLint> offsets, std::span<const GLsizei> instance_counts);
+
+        // Submits every command of `commands` with a single glMultiDrawArraysIndirect
+        void RenderMultiIndirect(Primitive primitive, const VertexBuffer& buffer, const IndirectBuffer& commands);
+
+        [[nodiscard]] const Statistics& GetStatistics() const noexcept;
+
+    private:
+
+        struct UniformBlock
+        {
+            GLuint binding { 0 };
+            size_t offset { 0 };
+            size_t size { 0 };
+        };
+
+        enum class CommandType
+        {
+            eMultiDraw,
+            eInstancedRanges,
+            eMultiIndirect,
+        };
+
+        struct Command
+        {
+            CommandType type { CommandType::eMultiDraw };
+
+            int target { -1 };
+            RenderState state;
+            std::array<int, UNIFORM_BLOCK_BINDINGS> uniform_blocks { };
+            std::uint32_t program_rank { 0 };
+            std::uint32_t buffer_rank { 0 };
+
+            const VertexBuffer* buffer { nullptr };
+            Primitive primitive { Primitive::eLines };
+
+            GLsizei instance_vertices { 0 };
+            const IndirectBuffer* indirect { nullptr };
+
+            size_t first_range { 0 };
+            size_t range_count { 0 };
+        };
+
+        void Record(Command command, std::span<const GLint> offsets, std::span<const GLsizei> sizes);
+
+        [[nodiscard]] static bool CanMerge(const Command& first, const Command& second);
+
+        [[nodiscard]] static std::uint32_t GetRank(std::unordered_map<const void*, std::uint32_t>& ranks, const void* object);
+
+        void ApplyState(const Command& command, const Command* previous);
+
+        void UploadUniformBlocks();
+
+    private:
+
+        std::vector<Command> m_commands;
+        std::vector<size_t> m_order;
+
+        std::vector<GLint> m_offsets;
+        std::vector<GLsizei> m_sizes;
+        std::vector<GLint> m_merged_offsets;
+        std::vector<GLsizei> m_merged_sizes;
+
+        std::unordered_map<const void*, std::uint32_t> m_program_ranks;
+        std::unordered_map<const void*, std::uint32_t> m_buffer_ranks;
+
+        std::vector<RenderTarget> m_targets;
+        int m_current_target { -1 };
+        RenderState m_current_state;
+
+        std::vector<std::uint8_t> m_uniform_data;
+        std::vector<UniformBlock> m_uniform_blocks;
+        std::array<int, UNIFORM_BLOCK_BINDINGS> m_current_blocks { };
+        size_t m_uniform_alignment { 0 };
+        std::unique_ptr<UniformBuffer> m_uniform_buffer;
+
+        glm::ivec2 m_window_size { 0 };
+        Statistics m_statistics;
 
     };
-}
\ No newline at end of file
+}
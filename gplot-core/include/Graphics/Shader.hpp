@@ -1,5 +1,7 @@
 #pragma once
 
+#include <string>
+#include <cstdint>
 #include <string_view>
 #include <unordered_map>
 
@@ -8,6 +10,32 @@
 
 namespace gplot::graphics
 {
+    // Uniform location resolved once, setting it skips the name lookup and the variant dispatch of Shader::Set.
+    // Like Shader::Set it writes to the program currently in use.
+    template<typename T>
+    class UniformHandle
+    {
+    public:
+
+        UniformHandle() = default;
+
+        explicit UniformHandle(int location) noexcept
+            : m_location(location)
+        {
+        }
+
+        void Set(const T& value) const;
+
+        [[nodiscard]] bool IsValid() const noexcept
+        {
+            return m_location != -1;
+        }
+
+    private:
+
+        int m_location { -1 };
+    };
+
     class Shader
     {
     public:
@@ -25,14 +53,62 @@ namespace gplot::graphics
 
         void Set(std::string_view name, UniformType data);
 
+        // GLSL 3.30 has no binding layout qualifier, blocks are assigned their binding point here
+        void BindUniformBlock(std::string_view name, unsigned int binding) const;
+
+        // Active uniforms are enumerated at link time, so resolving a handle never queries the driver
+        template<typename T>
+        [[nodiscard]] UniformHandle<T> Uniform(std::string_view name) const
+        {
+            return UniformHandle<T>(FindUniform(HashName(name), name));
+        }
+
+        template<typename T>
+        [[nodiscard]] UniformHandle<T> Uniform(std::uint64_t name_hash) const
+        {
+            return UniformHandle<T>(FindUniform(name_hash, { }));
+        }
+
+        // FNV-1a of a uniform name, constexpr so names can be hashed at compile time
+        [[nodiscard]] static constexpr std::uint64_t HashName(std::string_view name) noexcept
+        {
+            std::uint64_t hash = 0xCBF29CE484222325ULL;
+            for (const char c : name)
+            {
+                hash = (hash ^ static_cast<std::uint8_t>(c)) * 0x100000001B3ULL;
+            }
+
+            return hash;
+        }
+
+        // Linked programs are cached as driver binaries under this directory, keyed by the sources and the driver.
+        // The cache is off until a directory is set, an empty directory disables it again.
+        static void SetBinaryCacheDirectory(std::string directory);
+
+    private:
+
+        [[nodiscard]] static std::string GetBinaryCachePath(std::string_view name, const char* vertex_src, const char* fragment_src, const char* geometry_src);
+
+        bool CompileProgram(const char* vertex_src, const char* fragment_src, const char* geometry_src, bool retrievable);
+
+        bool LoadProgramBinary(const std::string& path);
+
+        void StoreProgramBinary(const std::string& path) const;
+
+        void CollectUniforms();
+
+        [[nodiscard]] int FindUniform(std::uint64_t name_hash, std::string_view name) const;
+
     private:
 
         unsigned int m_id { 0 };
 
-        std::unordered_map<std::string_view, int> m_uniform_location_cache;
+        // Keyed by HashName, names are not stored so callers may pass temporaries
+        std::unordered_map<std::uint64_t, int> m_uniform_locations;
+
+        static std::string s_cache_dir;
 
     };
 }
 
 #include <string_view>
-
@@ -0,0 +1,18 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+
+namespace gplot::graphics
+{
+    // Source of a built-in shader by its file name in resources/, e.g. "line.vert.glsl".
+    // The sources are embedded at build time. When an override directory is set, a file of the same name
+    // inside it takes precedence, which allows editing shaders without rebuilding.
+    [[nodiscard]] std::string GetShaderSource(std::string_view name);
+
+    // Defaults to the GPLOT_SHADER_DIR environment variable, an empty directory disables overrides
+    void SetShaderOverrideDirectory(std::string directory);
+
+    // Inserts `#define <define>` right after the #version line, used to select shader variants
+    [[nodiscard]] std::string AddShaderDefine(std::string_view source, std::string_view define);
+}
@@ -0,0 +1,97 @@
+#pragma once
+
+#include <glad/glad.h>
+
+#include <array>
+#include <cstddef>
+
+namespace gplot::graphics
+{
+    // Shadow copy of the GL bindings gplot-core touches. Binding what is already bound becomes a no-op.
+    // One instance per thread, which matches the context current on it. Call Invalidate after switching contexts
+    // or after foreign code changed bindings without restoring them.
+    class StateCache
+    {
+    public:
+
+        struct Counters
+        {
+            size_t issued { 0 };
+            size_t elided { 0 };
+        };
+
+    public:
+
+        [[nodiscard]] static StateCache& Get();
+
+        void UseProgram(GLuint program);
+
+        void BindVertexArray(GLuint vao);
+
+        void BindBuffer(GLenum target, GLuint buffer);
+
+        void BindBufferRange(GLenum target, GLuint index, GLuint buffer, GLintptr offset, GLsizeiptr size);
+
+        // GL_FRAMEBUFFER binds both the draw and the read framebuffer
+        void BindFramebuffer(GLenum target, GLuint framebuffer);
+
+        // Also makes `unit` the active texture unit
+        void BindTexture(GLuint unit, GLenum target, GLuint texture);
+
+        // Deleted objects are unbound by GL and their names may be reused, so the cache has to forget them
+        void ForgetProgram(GLuint program);
+
+        void ForgetVertexArray(GLuint vao);
+
+        void ForgetBuffer(GLuint buffer);
+
+        void ForgetFramebuffer(GLuint framebuffer);
+
+        void ForgetTexture(GLuint texture);
+
+        void Invalidate();
+
+        [[nodiscard]] const Counters& GetCounters() const noexcept;
+
+        void ResetCounters() noexcept;
+
+    private:
+
+        // Binding state the cache knows nothing about, never equal to a GL name in practice
+        static constexpr GLuint UNKNOWN = ~0U;
+
+        static constexpr size_t BUFFER_TARGETS = 8;
+        static constexpr size_t TEXTURE_TARGETS = 3;
+        static constexpr size_t TEXTURE_UNITS = 16;
+        static constexpr size_t INDEXED_BINDINGS = 16;
+
+        struct IndexedBinding
+        {
+            GLuint buffer { UNKNOWN };
+            GLintptr offset { 0 };
+            GLsizeiptr size { 0 };
+        };
+
+        // Tracks an elided or issued call, returns true when the call is needed
+        bool Track(GLuint& cached, GLuint value);
+
+        [[nodiscard]] static int GetBufferSlot(GLenum target);
+
+        [[nodiscard]] static int GetTextureSlot(GLenum target);
+
+    private:
+
+        GLuint m_program { UNKNOWN };
+        GLuint m_vao { UNKNOWN };
+        GLuint m_draw_framebuffer { UNKNOWN };
+        GLuint m_read_framebuffer { UNKNOWN };
+        GLuint m_active_unit { UNKNOWN };
+
+        std::array<GLuint, BUFFER_TARGETS> m_buffers;
+        std::array<IndexedBinding, INDEXED_BINDINGS> m_uniform_bindings;
+        std::array<std::array<GLuint, TEXTURE_TARGETS>, TEXTURE_UNITS> m_textures;
+
+        Counters m_counters;
+
+    };
+}
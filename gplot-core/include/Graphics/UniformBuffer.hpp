@@ -0,0 +1,40 @@
+#pragma once
+
+#include <glad/glad.h>
+
+#include <cstddef>
+
+namespace gplot::graphics
+{
+    class UniformBuffer
+    {
+    public:
+
+        explicit UniformBuffer(size_t size);
+
+        ~UniformBuffer() noexcept;
+
+        UniformBuffer(UniformBuffer&& other) = delete;
+        UniformBuffer(const UniformBuffer& other) = delete;
+        UniformBuffer& operator=(UniformBuffer&&) = delete;
+        UniformBuffer& operator=(const UniformBuffer&) = delete;
+
+        void Update(size_t offset, size_t size, const void* data) const;
+
+        // Detaches the storage from draws still reading it, the contents become undefined
+        void Orphan() const;
+
+        void BindRange(GLuint binding, size_t offset, size_t size) const;
+
+        [[nodiscard]] size_t GetSize() const noexcept;
+
+        // Required alignment of BindRange offsets
+        [[nodiscard]] static size_t GetOffsetAlignment();
+
+    private:
+
+        GLuint m_id { 0 };
+        size_t m_size { 0 };
+
+    };
+}
@@ -2,6 +2,7 @@
 
 #include <array>
 #include <vector>
+#include <cstddef>
 #include <variant>
 #include <glad/glad.h>
 
@@ -18,8 +19,15 @@ namespace gplot::graphics
             eInt32,
             eUInt32,
             eFloat32,
+
+            eFloat16,
+            eInt16,
+            eUInt16,
+            eUInt8,
         };
 
+        // Normalized integer attributes reach the shader as floats in [0, 1] ([-1, 1] when signed),
+        // the others as integers
         struct GeometryBufferAttributes
         {
             size_t data_count { 1 };
@@ -30,6 +38,9 @@ namespace gplot::graphics
         struct GeometryBufferDescriptor
         {
             std::vector<GeometryBufferAttributes> attributes;
+
+            // Non-zero makes the attributes per instance, advancing once every `divisor` instances
+            GLuint divisor { 0 };
         };
 
         struct VertexBufferDescriptor
@@ -50,6 +61,10 @@ namespace gplot::graphics
 
         void Bind() const;
 
+        // Binds a second VAO with only the per-instance attributes enabled, for draws that pull their per-vertex
+        // data from buffer textures and run gl_VertexID past the vertex count
+        void BindInstanceAttributes() const;
+
         static void Unbind();
 
         void UnmapBuffer(int id) const;
@@ -62,16 +77,52 @@ namespace gplot::graphics
 
         void Resize(int id, size_t size) const;
 
-        void Update(int id, size_t size, const void* data, int offset = 0) const;
+        // Sizes and offsets are in bytes
+        void Update(int id, size_t size, const void* data, size_t offset = 0) const;
+
+        [[nodiscard]] GLuint GetBufferId(int id) const noexcept;
+
+        // Persistent mode: immutable, persistently and coherently mapped storage split into fenced regions.
+        // Every frame writes into its own region while the GPU may still read the previous ones.
+        [[nodiscard]] static bool IsPersistentStorageSupported();
+
+        void CreatePersistentStorage(size_t region_vertex_count, size_t regions);
+
+        [[nodiscard]] size_t BeginPersistentRegion();
+
+        void EndPersistentRegion();
+
+        [[nodiscard]] size_t GetPersistentRegionCapacity() const noexcept;
+
+        template<typename T>
+        [[nodiscard]] T* GetPersistentRegion(int id) const
+        {
+            return reinterpret_cast<T*>(m_persistent_ptrs[id] + m_persistent_region * m_persistent_capacity * m_strides[id]);
+        }
 
     private:
 
         [[nodiscard]] void* MapBufferInternal(int id, size_t offset, size_t length, GLbitfield flags) const;
 
+        void SetupAttributes(int id) const;
+
+        void SetupInstanceAttributes() const;
+
+        void ReleasePersistentStorage();
+
     private:
 
         GLuint m_VAO { 0 };
+        GLuint m_instance_VAO { 0 };
 
         std::vector<GLuint> m_VBO { 0 };
+
+        VertexBufferDescriptor m_descriptor;
+        std::vector<size_t> m_strides;
+
+        std::vector<char*> m_persistent_ptrs;
+        std::vector<GLsync> m_persistent_fences;
+        size_t m_persistent_region { 0 };
+        size_t m_persistent_capacity { 0 };
     };
 }
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <Plotting/PlottingTypes.hpp>
+
+#include <glad/glad.h>
+
+#include <vector>
+#include <cstdint>
+
+namespace gplot
+{
+    constexpr size_t COLORMAP_COUNT = 5;
+
+    // Colors of `colormap` sampled at `count` evenly spaced points, packed as RGBA8 bytes
+    [[nodiscard]] std::vector<std::uint8_t> SampleColormap(Colormap colormap, size_t count);
+
+    // 1D RGBA8 texture of a colormap, linearly filtered and clamped so values outside the range saturate
+    class ColormapTexture
+    {
+    public:
+
+        static constexpr size_t SIZE = 256;
+
+    public:
+
+        explicit ColormapTexture(Colormap colormap);
+
+        ~ColormapTexture() noexcept;
+
+        ColormapTexture(ColormapTexture&& other) = delete;
+        ColormapTexture(const ColormapTexture& other) = delete;
+        ColormapTexture& operator=(ColormapTexture&&) = delete;
+        ColormapTexture& operator=(const ColormapTexture&) = delete;
+
+        [[nodiscard]] GLuint GetTextureId() const noexcept;
+
+    private:
+
+        GLuint m_texture { 0 };
+
+    };
+}
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <span>
+#include <vector>
+
+#include <Core/Math.hpp>
+
+namespace gplot
+{
+    // Indices of the first, lowest, highest and last vertex of a run of samples
+    struct MinMaxSummary
+    {
+        size_t first { 0 };
+        size_t min { 0 };
+        size_t max { 0 };
+        size_t last { 0 };
+    };
+
+    // Maps x to its pixel column, everything outside [x_min, x_max] falls into column -1 or `columns`, NaN into `columns`
+    struct ColumnMapping
+    {
+        ColumnMapping(float x_min, float x_max, int columns);
+
+        [[nodiscard]] int operator()(float x) const;
+
+        float x_min { 0.0F };
+        float scale { 0.0F };
+        int columns { 0 };
+    };
+
+    // Appends the summarized vertices in their original order, skipping repeated indices
+    void EmitMinMax(std::span<const gplot::core::Vertex> vertices, const MinMaxSummary& summary, std::vector<gplot::core::Vertex>& output);
+
+    // M4 decimation: splits [x_min, x_max] into `columns` pixel columns and keeps the first, min, max and last vertex
+    // of every column, plus the same four for everything left and right of the range. Rasterizing the result
+    // produces the same pixels as the full line. Expects vertices ordered by x.
+    void DecimateMinMax(std::span<const gplot::core::Vertex> vertices, float x_min, float x_max, int columns, std::vector<gplot::core::Vertex>& output);
+
+    // Largest-Triangle-Three-Buckets: keeps `target` vertices that preserve the visual shape of the line, independent
+    // of the view. Meant for overviews where an approximate but faithful preview is enough. Expects vertices ordered by x.
+    void DecimateLTTB(std::span<const gplot::core::Vertex> vertices, size_t target, std::vector<gplot::core::Vertex>& output);
+
+    // Runs DecimateLTTB for every line, spread over the default thread pool
+    [[nodiscard]] std::vector<std::vector<gplot::core::Vertex>> DecimateLTTB(const std::vector<std::vector<gplot::core::Vertex>>& lines, size_t target);
+}
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <Graphics/UniformBuffer.hpp>
+
+#include <glm/glm.hpp>
+
+namespace gplot
+{
+    // Per-frame state of every gplot program, bound as the std140 block "FrameData" at BINDING.
+    // Each Push appends one block to a streaming buffer and binds it, so plotters sharing an instance
+    // (see PlotterDescriptor::frame_uniforms) stream all their per-plot state through a single UBO.
+    class FrameUniforms
+    {
+    public:
+
+        static constexpr GLuint BINDING = 0;
+
+        // Mirrors the FrameData block declared in the shaders, std140 layout
+        struct Block
+        {
+            glm::mat4 view_matrix { 1.0F };
+            float line_thickness { 0.0F };
+            float line_feather { 0.0F };
+            // Scale of the stored positions, quantized series keep them as normalized integers
+            glm::vec2 position_scale { 1.0F };
+        };
+
+    public:
+
+        explicit FrameUniforms(size_t capacity = 64);
+
+        FrameUniforms(FrameUniforms&& other) = delete;
+        FrameUniforms(const FrameUniforms& other) = delete;
+        FrameUniforms& operator=(FrameUniforms&&) = delete;
+        FrameUniforms& operator=(const FrameUniforms&) = delete;
+
+        void Push(const Block& block);
+
+    private:
+
+        size_t m_stride;
+        size_t m_capacity;
+        size_t m_next { 0 };
+
+        gplot::graphics::UniformBuffer m_buffer;
+
+    };
+}
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <span>
+#include <vector>
+#include <cstdint>
+
+#include <Core/Math.hpp>
+#include <Plotting/Decimation.hpp>
+
+namespace gplot
+{
+    // Mipmap-like chain of first/min/max/last summaries over an x-ordered series. Level 0 summarizes BASE_BUCKET
+    // samples per bucket, every next level merges FANOUT buckets of the previous one.
+    class MinMaxPyramid
+    {
+    public:
+
+        constexpr static size_t BASE_BUCKET = 8;
+        constexpr static size_t FANOUT = 4;
+
+        struct Bucket
+        {
+            std::uint32_t first { 0 };
+            std::uint32_t min { 0 };
+            std::uint32_t max { 0 };
+            std::uint32_t last { 0 };
+        };
+
+    public:
+
+        void Build(std::span<const gplot::core::Vertex> vertices);
+
+        // Recomputes only the buckets touched by the samples past `previous_size`
+        void Extend(std::span<const gplot::core::Vertex> vertices, size_t previous_size);
+
+        void Clear();
+
+        [[nodiscard]] bool IsEmpty() const noexcept;
+
+        [[nodiscard]] size_t GetLevelCount() const noexcept;
+
+        // Picks the coarsest level whose average bucket is no wider than one of `columns` pixel columns over
+        // [x_min, x_max], or -1 when even level 0 is too coarse and the raw samples have to be used
+        [[nodiscard]] int ChooseLevel(std::span<const gplot::core::Vertex> vertices, float x_min, float x_max, int columns) const;
+
+        // Writes the vertices needed to draw [x_min, x_max]: the summaries of the visible buckets of the chosen level,
+        // or the visible raw samples, in both cases padded by one bucket on each side. Buckets that straddle a pixel
+        // column are refined through the finer levels, so DecimateMinMax over the output matches it over the raw data.
+        void Collect(std::span<const gplot::core::Vertex> vertices, float x_min, float x_max, int columns, std::vector<gplot::core::Vertex>& output) const;
+
+    private:
+
+        void CollectBucket(std::span<const gplot::core::Vertex> vertices, size_t level, size_t index, const ColumnMapping& column_of, std::vector<gplot::core::Vertex>& output) const;
+
+    private:
+
+        std::vector<std::vector<Bucket>> m_levels;
+
+    };
+}
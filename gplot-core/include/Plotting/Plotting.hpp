@@ -1,7 +1,17 @@
 #pragma once
 
+#include <span>
+#include <array>
+#include <memory>
+
 #include <Graphics/Shader.hpp>
+#include <Graphics/Renderer.hpp>
+#include <Graphics/BufferTexture.hpp>
 #include <Graphics/VertexBuffer.hpp>
+#include <Graphics/IndirectBuffer.hpp>
+#include <Plotting/Colormap.hpp>
+#include <Plotting/FrameUniforms.hpp>
+#include <Plotting/MinMaxPyramid.hpp>
 #include <Plotting/PlottingTypes.hpp>
 
 namespace gplot
@@ -10,31 +20,311 @@ namespace gplot
     {
     public:
 
-        explicit Plotter();
+        explicit Plotter(const PlotterDescriptor& descriptor = { });
 
         void PlotLines(const std::vector<std::vector<gplot::core::Vertex>>& lines, const std::vector<glm::vec4>& colors, core::RectF bounds, CameraViewport camera, float line_thickness = 0.05F, float line_feather = 0.05F);
 
+        // Retained mode: series are uploaded once and only re-sent to the GPU when their data changes
+        [[nodiscard]] SeriesHandle AddSeries(std::vector<gplot::core::Vertex> vertices, glm::vec4 color);
+
+        void UpdateSeries(SeriesHandle handle, std::vector<gplot::core::Vertex> vertices);
+
+        void SetSeriesColor(SeriesHandle handle, glm::vec4 color);
+
+        void RemoveSeries(SeriesHandle handle);
+
+        // Streaming series live in a fixed-capacity GPU ring, appending past the capacity drops the oldest samples.
+        // Decimation does not apply to them.
+        [[nodiscard]] SeriesHandle AddStreamingSeries(size_t capacity, glm::vec4 color);
+
+        void AppendSeries(SeriesHandle handle, std::span<const gplot::core::Vertex> vertices);
+
+        // Colormapped series take their color from one scalar per vertex looked up in `colormap`. The value range
+        // only feeds a uniform, so changing it never re-uploads the series. Decimation does not apply to them.
+        [[nodiscard]] SeriesHandle AddColormappedSeries(std::vector<gplot::core::Vertex> vertices, std::vector<float> values, Colormap colormap, glm::vec2 value_range);
+
+        void UpdateSeriesValues(SeriesHandle handle, std::vector<float> values);
+
+        void SetSeriesColormap(SeriesHandle handle, Colormap colormap);
+
+        void SetSeriesValueRange(SeriesHandle handle, glm::vec2 value_range);
+
+        // Precise series keep double data split into chunks, each stored as float offsets from its own origin.
+        // Chunks near the camera are moved onto it before float offsets stop resolving a pixel, so deep zooms
+        // into wide ranges (e.g. nanosecond timestamps) stay still. Decimation does not apply to them.
+        [[nodiscard]] SeriesHandle AddPreciseSeries(std::vector<glm::dvec2> points, glm::vec4 color);
+
+        void UpdatePreciseSeries(SeriesHandle handle, std::vector<glm::dvec2> points);
+
+        void AppendPreciseSeries(SeriesHandle handle, std::span<const glm::dvec2> points);
+
+        void TrimSeries(SeriesHandle handle, size_t count);
+
+        // Min/max series are reduced against the camera x-range and the canvas width before upload,
+        // LTTB series are reduced once per data change to `target_points` vertices.
+        // Both expect vertices sorted by x, unsorted series are decimated into a wrong shape.
+        void SetSeriesDecimation(SeriesHandle handle, Decimation decimation, size_t target_points = 2048);
+
+        void SetCanvasSize(int width, int height);
+
+        // Series flagged as sorted by x only submit the vertices inside the camera x-range
+        void SetSeriesSortedX(SeriesHandle handle, bool sorted_x);
+
+        // Hidden series keep their GPU data, toggling only rewrites their draw command
+        void SetSeriesVisible(SeriesHandle handle, bool visible);
+
+        void Render(core::RectF bounds, CameraViewport camera, float line_thickness = 0.05F, float line_feather = 0.05F);
+
+        // Records the grid and the retained series into a shared renderer, several plots then submit as one sorted list.
+        // The plotter must outlive the renderer's next RenderCurrent.
+        void Record(gplot::graphics::Renderer& renderer, core::RectF bounds, CameraViewport camera, float line_thickness = 0.05F, float line_feather = 0.05F);
+
+        // Changes to eGeometryShader once a buffer outgrows what the instanced pipeline can address
+        [[nodiscard]] LinePipeline GetLinePipeline() const noexcept;
+
     private:
 
-        void RenderGrid(core::RectF bounds, int count_x, int count_y) const;
+        static constexpr size_t NO_DRAW_COMMAND = ~size_t(0);
+        static constexpr size_t NO_DETAIL_SLOT = ~size_t(0);
+
+        struct PreciseChunk
+        {
+            // Source points [begin, end), offsets from `origin` are stored in the chunk's slot of the series buffer
+            size_t begin { 0 };
+            size_t end { 0 };
+            glm::dvec2 origin { 0.0 };
+            core::RectD bounds;
+
+            // World size of one quantization step per axis, 1 for float chunks
+            glm::dvec2 scale { 1.0 };
+
+            // Quantized chunks only: float offsets from detail_origin in the series' detail store while zoomed past their steps
+            size_t detail_slot { NO_DETAIL_SLOT };
+            glm::dvec2 detail_origin { 0.0 };
+
+            // Per-frame state of RecordPrecise
+            bool visible { false };
+            bool detailed { false };
+        };
+
+        struct LineSeries
+        {
+            bool alive { false };
+            glm::vec4 color { 1.0F };
+            std::vector<gplot::core::Vertex> vertices;
+
+            // Location of the series inside m_series_buffer, valid while the layout is not dirty. Min/max views
+            // reserve `capacity` vertices there so a camera move rewrites only their own region.
+            size_t first { 0 };
+            size_t count { 0 };
+            size_t capacity { 0 };
+
+            bool sorted_x { false };
+            bool visible { true };
+
+            // Indirect draws only, command of the series and its instance count while visible
+            size_t draw_index { NO_DRAW_COMMAND };
+            GLuint draw_instances { 0 };
+
+            Decimation decimation { Decimation::eNone };
+            size_t decimation_target { 0 };
+            std::vector<gplot::core::Vertex> decimated;
+            MinMaxPyramid pyramid;
+            bool view_dirty { true };
+
+            // Streaming series only: the ring storage, `vertices` mirrors it and holds ring_capacity elements
+            std::unique_ptr<gplot::graphics::VertexBuffer> ring;
+            size_t ring_capacity { 0 };
+            size_t ring_head { 0 };
+            size_t ring_size { 0 };
+
+            // Colormapped series only: positions and values live in their own buffer, `count` vertices of it are drawn
+            std::unique_ptr<gplot::graphics::VertexBuffer> mapped;
+            std::vector<float> values;
+            Colormap colormap { Colormap::eViridis };
+            glm::vec2 value_range { 0.0F, 1.0F };
+            bool mapped_dirty { false };
+
+            // Precise series only: chunks [0, precise_valid) are uploaded and match `points`
+            std::unique_ptr<gplot::graphics::VertexBuffer> precise;
+            std::vector<glm::dvec2> points;
+            std::vector<PreciseChunk> chunks;
+            size_t precise_valid { 0 };
+            size_t precise_capacity { 0 };
+
+            // Quantized series only: float chunk slots, indexed by slot and holding their chunk
+            std::unique_ptr<gplot::graphics::VertexBuffer> detail;
+            std::vector<size_t> detail_owners;
+        };
+
+        void RenderGrid(core::RectF bounds, int count_x, int count_y);
+
+        void UpdateGrid(core::RectF bounds, int count_x, int count_y);
 
         static gplot::graphics::Shader LoadGridShader();
 
-        static gplot::graphics::Shader LoadLineShader();
+        [[nodiscard]] static std::unique_ptr<gplot::graphics::Shader> LoadLineShader(LinePipeline pipeline);
+
+        // Instanced pipeline with per-series colors only, the geometry shader pipeline reads the table through the VAO
+        [[nodiscard]] static std::unique_ptr<gplot::graphics::Shader> LoadSeriesShader(LinePipeline pipeline, bool per_series_colors);
+
+        [[nodiscard]] static bool ResolvePerSeriesColors(const PlotterDescriptor& descriptor);
+
+        [[nodiscard]] const gplot::graphics::Shader& GetSeriesShader() const noexcept;
+
+        [[nodiscard]] const gplot::graphics::Shader& GetColormapShader();
+
+        [[nodiscard]] GLuint GetColormapTexture(Colormap colormap);
+
+        [[nodiscard]] static LinePipeline ResolveLinePipeline(LinePipeline pipeline);
+
+        // Falls back to the geometry shader pipeline when a buffer texture would have to address more than m_max_texels
+        void ReserveTexels(size_t texels);
+
+        // Largest series buffer drawn this frame, called before the first line state is recorded
+        void ReserveSeriesTexels();
+
+        static gplot::graphics::VertexBuffer CreateVertexBuffer(bool per_series_colors = false);
 
-        static gplot::graphics::VertexBuffer CreateVertexBuffer();
+        static gplot::graphics::VertexBuffer::VertexBufferDescriptor CreateVertexBufferDescriptor(bool per_series_colors = false);
 
-        void PlotLinesInternal(const std::vector<std::vector<gplot::core::Vertex>>& lines, const std::vector<glm::vec4>& colors, const gplot::graphics::VertexBuffer& buffer) const;
+        static gplot::graphics::VertexBuffer::VertexBufferDescriptor CreateColormapBufferDescriptor();
+
+        // Positions as normalized 16-bit pairs, colors as in CreateVertexBufferDescriptor
+        static gplot::graphics::VertexBuffer::VertexBufferDescriptor CreateQuantizedBufferDescriptor();
+
+        void PlotLinesInternal(const std::vector<std::vector<gplot::core::Vertex>>& lines, const std::vector<glm::vec4>& colors, const gplot::graphics::VertexBuffer& buffer);
+
+        void PlotLinesPersistent(const std::vector<std::vector<gplot::core::Vertex>>& lines, const std::vector<glm::vec4>& colors);
+
+        static void UploadLines(const std::vector<std::vector<gplot::core::Vertex>>& lines, const std::vector<glm::vec4>& colors, const gplot::graphics::VertexBuffer& buffer, std::vector<GLint>& firsts, std::vector<GLsizei>& sizes);
+
+        static void DrawLines(const gplot::graphics::VertexBuffer& buffer, const std::vector<GLint>& firsts, const std::vector<GLsizei>& sizes);
+
+        // Draws strips with the line shader and the active pipeline, ranges follow the strip-adjacency layout in both cases
+        void DrawLineRanges(const gplot::graphics::VertexBuffer& buffer, const GLint* firsts, const GLsizei* sizes, GLsizei count);
+
+        void RecordLineRanges(gplot::graphics::Renderer& renderer, const gplot::graphics::Renderer::RenderState& state, const gplot::graphics::VertexBuffer& buffer, std::span<const GLint> firsts, std::span<const GLsizei> sizes);
+
+        // Series state of `shader`, the instanced pipeline fetches positions and the second attribute through buffer textures
+        [[nodiscard]] gplot::graphics::Renderer::RenderState MakeLineState(const gplot::graphics::Shader& shader, const gplot::graphics::VertexBuffer& buffer, const gplot::graphics::BufferTexture& attribute_texture, GLenum attribute_format, GLenum position_format = GL_RG32F) const;
+
+        [[nodiscard]] SeriesHandle AllocateSeries();
+
+        [[nodiscard]] LineSeries* FindSeries(SeriesHandle handle);
+
+        // Packed series share m_series_buffer, streaming, colormapped and precise series own their storage
+        [[nodiscard]] static bool IsPacked(const LineSeries& series);
+
+        void UpdateSeriesViews(const CameraViewport& camera);
+
+        void UploadSeries();
+
+        void BuildSeriesDraws(glm::vec2 range);
+
+        void UpdateSeriesDraws(glm::vec2 range);
+
+        // Visible part [begin, end) of a packed series, relative to its first vertex
+        [[nodiscard]] static std::pair<size_t, size_t> GetSeriesDrawRange(const LineSeries& series, glm::vec2 range);
+
+        [[nodiscard]] gplot::graphics::IndirectBuffer::DrawArraysCommand MakeDrawCommand(size_t first, size_t size) const;
+
+        [[nodiscard]] static const std::vector<gplot::core::Vertex>& GetDrawnVertices(const LineSeries& series);
+
+        static void WriteRing(LineSeries& series, std::span<const gplot::core::Vertex> vertices);
+
+        static void FillRingColor(const LineSeries& series);
+
+        void RecordRing(gplot::graphics::Renderer& renderer, const LineSeries& series, glm::vec2 range);
+
+        void RecordColormapped(gplot::graphics::Renderer& renderer, LineSeries& series, glm::vec2 range);
+
+        void UploadPrecise(LineSeries& series);
+
+        void UploadChunkOffsets(const LineSeries& series, const PreciseChunk& chunk, glm::dvec2 origin, const gplot::graphics::VertexBuffer& buffer, size_t slot);
+
+        void UploadQuantizedChunk(const LineSeries& series, size_t index);
+
+        static void FillPreciseColor(const LineSeries& series);
+
+        // Gives every chunk flagged `detailed` a slot of the detail store, keeping the slots that are still in use
+        void AssignDetailSlots(LineSeries& series, size_t needed);
+
+        [[nodiscard]] size_t GetChunkVertexSize() const noexcept;
+
+        // Each visible chunk is drawn with its own frame block, whose view matrix carries the chunk origin
+        void RecordPrecise(gplot::graphics::Renderer& renderer, LineSeries& series, const CameraViewport& camera, FrameUniforms::Block frame);
 
     private:
 
-        gplot::graphics::Shader m_shader;
+        PlotterDescriptor m_descriptor;
+
+        LinePipeline m_line_pipeline;
+
+        // Retained series read their color from a table holding one entry per draw command
+        bool m_per_series_colors;
+
+        ChunkEncoding m_chunk_encoding;
+
+        // GL_MAX_TEXTURE_BUFFER_SIZE, buffers bound as buffer textures are checked against it as they grow
+        size_t m_max_texels;
+
+        std::unique_ptr<gplot::graphics::Shader> m_shader;
+        std::unique_ptr<gplot::graphics::Shader> m_series_shader;
+
+        gplot::graphics::BufferTexture m_position_texture;
+        gplot::graphics::BufferTexture m_color_texture;
+        gplot::graphics::BufferTexture m_value_texture;
+
+        // Created on the first colormapped series
+        std::unique_ptr<gplot::graphics::Shader> m_colormap_shader;
+        std::array<std::unique_ptr<ColormapTexture>, COLORMAP_COUNT> m_colormaps;
 
         gplot::graphics::Shader m_grid_shader;
 
+        std::shared_ptr<FrameUniforms> m_frame_uniforms;
+
         gplot::graphics::VertexBuffer m_buffer;
+        bool m_persistent_buffer { false };
+        std::vector<GLint> m_buffer_firsts;
+        std::vector<GLsizei> m_buffer_sizes;
 
         gplot::graphics::VertexBuffer m_grid_buffer;
 
+        core::RectF m_grid_bounds;
+        std::vector<GLint> m_grid_firsts;
+        std::vector<GLsizei> m_grid_sizes;
+
+        gplot::graphics::VertexBuffer m_series_buffer;
+
+        std::vector<LineSeries> m_series;
+        std::vector<std::uint32_t> m_free_series;
+
+        glm::ivec2 m_canvas_size { 0 };
+        glm::vec2 m_view_range { 0.0F };
+        int m_view_columns { 0 };
+        std::vector<gplot::core::Vertex> m_view_scratch;
+
+        bool m_series_layout_dirty { false };
+        size_t m_series_capacity { 0 };
+
+        std::vector<GLint> m_series_firsts;
+        std::vector<GLsizei> m_series_sizes;
+
+        bool m_indirect_draws { false };
+        gplot::graphics::IndirectBuffer m_series_draws;
+        std::vector<gplot::graphics::IndirectBuffer::DrawArraysCommand> m_draw_commands;
+        bool m_series_draws_dirty { true };
+        bool m_draws_follow_range { false };
+        glm::vec2 m_draws_range { 0.0F };
+        std::vector<gplot::core::Color> m_draw_colors;
+        size_t m_draw_color_capacity { 0 };
+
+        gplot::graphics::Renderer m_renderer;
+        std::vector<GLint> m_record_firsts;
+        std::vector<GLsizei> m_record_sizes;
+        std::vector<gplot::core::Vertex> m_precise_scratch;
+        std::vector<glm::u16vec2> m_quantized_scratch;
+
     };
-}
\ No newline at end of file
+}
@@ -2,21 +2,90 @@
 
 #include <Core/Math.hpp>
 
+#include <memory>
+
 namespace gplot
 {
+    class FrameUniforms;
+
+    enum class SeriesHandle : std::uint32_t
+    {
+        eInvalid = 0,
+    };
+
+    enum class Decimation
+    {
+        eNone,
+        eMinMax,
+        eLTTB,
+    };
+
+    enum class LinePipeline
+    {
+        eAuto,
+        eGeometryShader,
+        eInstanced,
+    };
+
+    enum class Colormap
+    {
+        eViridis,
+        eMagma,
+        eInferno,
+        ePlasma,
+        eGrayscale,
+    };
+
+    enum class SeriesColors
+    {
+        ePerVertex, // packed color repeated for every vertex, required for per-vertex coloring
+        ePerSeries, // one packed color per series in a table indexed by the draw's base instance
+    };
+
+    // Vertex storage of precise series chunks
+    enum class ChunkEncoding
+    {
+        eFloat32, // float offsets from the chunk origin, moved onto the camera on deep zooms
+        eUNorm16, // 16-bit steps across the chunk's bounds, half the memory, exact while a chunk spans fewer than 65536 pixels
+    };
+
+    struct PlotterDescriptor
+    {
+        // eAuto prefers instanced segments pulled from buffer textures and falls back to the geometry shader
+        // when the context cannot address enough texels
+        LinePipeline line_pipeline { LinePipeline::eAuto };
+
+        // Stream PlotLines data through persistently mapped, fenced buffers when the context supports it
+        bool persistent_buffers { true };
+        size_t persistent_regions { 3 };
+
+        // Keep retained series draws in an indirect command buffer, rebuilt only when the series set changes
+        bool indirect_draws { true };
+
+        // Where retained series keep their color, ePerSeries needs indirect draws and falls back to ePerVertex
+        SeriesColors series_colors { SeriesColors::ePerSeries };
+
+        ChunkEncoding chunk_encoding { ChunkEncoding::eFloat32 };
+
+        // Shared per-frame uniform stream, plotters of one dashboard can pass the same instance.
+        // Left empty, the plotter creates its own.
+        std::shared_ptr<FrameUniforms> frame_uniforms;
+    };
+
+    // Double precision, so the camera can address a narrow window of a wide range (e.g. epoch nanoseconds)
     struct CameraViewport
     {
-        glm::vec2 center { 0, 0 };
-        glm::vec2 proportions { 2, 2 };
+        glm::dvec2 center { 0, 0 };
+        glm::dvec2 proportions { 2, 2 };
 
-        void PanView(glm::vec2 delta)
+        void PanView(glm::dvec2 delta)
         {
             center += delta;
         }
 
-        void AdjustZoom(float factor)
+        void AdjustZoom(double factor)
         {
             proportions /= factor;
         }
     };
-}
\ No newline at end of file
+}
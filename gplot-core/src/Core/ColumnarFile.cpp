@@ -0,0 +1,305 @@
+#include <Core/ColumnarFile.hpp>
+
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+#include <algorithm>
+
+using namespace gplot::core;
+
+namespace
+{
+    constexpr char MAGIC[8] = { 'G', 'P', 'L', 'O', 'T', 'C', 'O', 'L' };
+    constexpr std::uint32_t VERSION = 1;
+
+    // On-disk layout, every field is naturally aligned so the structs carry no padding
+    struct FileHeader
+    {
+        char magic[8];
+        std::uint32_t version;
+        std::uint32_t column_count;
+    };
+
+    struct ColumnHeader
+    {
+        char name[ColumnarFile::MAX_NAME_LENGTH + 1];
+        std::uint32_t type;
+        std::uint32_t reserved;
+        std::uint64_t length;
+        std::uint64_t offset;
+        std::uint64_t nan_count;
+        double min[2];
+        double max[2];
+    };
+
+    static_assert(sizeof(FileHeader) == 16 && sizeof(ColumnHeader) == 96, "Columnar headers must match the file layout");
+
+    size_t GetElementSize(std::uint32_t type)
+    {
+        switch (static_cast<ColumnType>(type))
+        {
+            case ColumnType::eFloat32:
+                return sizeof(float);
+            case ColumnType::eFloat64:
+                return sizeof(double);
+            case ColumnType::eInt64:
+                return sizeof(std::int64_t);
+            case ColumnType::eVertex:
+                return sizeof(Vertex);
+            default:
+                break;
+        }
+
+        return 0;
+    }
+
+    size_t AlignColumn(size_t offset)
+    {
+        return (offset + ColumnarFile::COLUMN_ALIGNMENT - 1) / ColumnarFile::COLUMN_ALIGNMENT * ColumnarFile::COLUMN_ALIGNMENT;
+    }
+
+    void SetRange(ColumnHeader& header, int component, double min, double max)
+    {
+        // Columns without finite values keep an empty range
+        if (min <= max)
+        {
+            header.min[component] = min;
+            header.max[component] = max;
+        }
+    }
+
+    template<typename T>
+    void ScanScalarColumn(ColumnHeader& header, std::span<const T> values)
+    {
+        double min = std::numeric_limits<double>::max();
+        double max = std::numeric_limits<double>::lowest();
+        for (const T value : values)
+        {
+            const auto converted = static_cast<double>(value);
+            if (std::isnan(converted))
+            {
+                header.nan_count++;
+            }
+            else if (std::isfinite(converted))
+            {
+                min = std::min(min, converted);
+                max = std::max(max, converted);
+            }
+        }
+
+        SetRange(header, 0, min, max);
+    }
+
+    void ScanColumn(ColumnHeader& header, std::span<const std::byte> data)
+    {
+        std::fill(std::begin(header.min), std::end(header.min), std::numeric_limits<double>::max());
+        std::fill(std::begin(header.max), std::end(header.max), std::numeric_limits<double>::lowest());
+        header.nan_count = 0;
+
+        switch (static_cast<ColumnType>(header.type))
+        {
+            case ColumnType::eFloat32:
+            {
+                const auto range = ScanValueRange({ reinterpret_cast<const float*>(data.data()), header.length });
+                header.nan_count = range.nan_count;
+                SetRange(header, 0, range.finite_min, range.finite_max);
+                break;
+            }
+            case ColumnType::eVertex:
+            {
+                const auto range = ScanDataRange({ reinterpret_cast<const Vertex*>(data.data()), header.length });
+                header.nan_count = range.nan_count;
+                SetRange(header, 0, range.finite.min.x, range.finite.max.x);
+                SetRange(header, 1, range.finite.min.y, range.finite.max.y);
+                break;
+            }
+            case ColumnType::eFloat64:
+                ScanScalarColumn<double>(header, { reinterpret_cast<const double*>(data.data()), header.length });
+                break;
+            case ColumnType::eInt64:
+                ScanScalarColumn<std::int64_t>(header, { reinterpret_cast<const std::int64_t*>(data.data()), header.length });
+                break;
+        }
+    }
+}
+
+ColumnarFile::ColumnarFile(std::string_view path)
+    : m_file(path)
+{
+    const auto data = m_file.GetData();
+
+    FileHeader file_header { };
+    if (data.size() < sizeof(FileHeader))
+    {
+        throw std::runtime_error("Columnar file is too small: " + std::string(path));
+    }
+    std::memcpy(&file_header, data.data(), sizeof(FileHeader));
+
+    if (std::memcmp(file_header.magic, MAGIC, sizeof(MAGIC)) != 0 || file_header.version != VERSION)
+    {
+        throw std::runtime_error("Not a gplot columnar file, or an unsupported version: " + std::string(path));
+    }
+
+    if (file_header.column_count > (data.size() - sizeof(FileHeader)) / sizeof(ColumnHeader))
+    {
+        throw std::runtime_error("Columnar file headers are truncated: " + std::string(path));
+    }
+
+    m_columns.resize(file_header.column_count);
+    for (size_t i = 0; i < m_columns.size(); i++)
+    {
+        ColumnHeader header { };
+        std::memcpy(&header, data.data() + sizeof(FileHeader) + i * sizeof(ColumnHeader), sizeof(ColumnHeader));
+
+        // Lengths are bounded by the file size before they are multiplied, so the checks cannot overflow
+        const size_t element_size = GetElementSize(header.type);
+        if (element_size == 0 || header.offset % COLUMN_ALIGNMENT != 0 || header.offset > data.size() || header.length > (data.size() - header.offset) / element_size)
+        {
+            throw std::runtime_error("Columnar file has an invalid column " + std::to_string(i) + ": " + std::string(path));
+        }
+
+        auto& column = m_columns[i];
+        column.name.assign(header.name, strnlen(header.name, sizeof(header.name)));
+        column.type = static_cast<ColumnType>(header.type);
+        column.length = header.length;
+        column.nan_count = header.nan_count;
+        column.min = { header.min[0], header.min[1] };
+        column.max = { header.max[0], header.max[1] };
+        column.offset = header.offset;
+    }
+}
+
+bool ColumnarFile::Write(std::string_view path, std::span<const ColumnSource> columns)
+{
+    std::vector<ColumnHeader> headers(columns.size());
+
+    size_t offset = AlignColumn(sizeof(FileHeader) + sizeof(ColumnHeader) * headers.size());
+    for (size_t i = 0; i < columns.size(); i++)
+    {
+        const auto& source = columns[i];
+        auto& header = headers[i];
+
+        const size_t element_size = GetElementSize(static_cast<std::uint32_t>(source.type));
+        if (element_size == 0 || source.data.size() % element_size != 0)
+        {
+            std::cerr << __FILE__ << ":" << __LINE__ << " Column data does not match its type: " << source.name << std::endl;
+            return false;
+        }
+
+        const size_t name_length = std::min(source.name.size(), MAX_NAME_LENGTH);
+        std::memcpy(header.name, source.name.data(), name_length);
+
+        header.type = static_cast<std::uint32_t>(source.type);
+        header.length = source.data.size() / element_size;
+        header.offset = offset;
+        ScanColumn(header, source.data);
+
+        offset = AlignColumn(offset + source.data.size());
+    }
+
+    std::ofstream file(std::string(path), std::ios::binary);
+    if (!file.is_open())
+    {
+        std::cerr << __FILE__ << ":" << __LINE__ << " Failed to open file: " << path << std::endl;
+        return false;
+    }
+
+    FileHeader file_header { };
+    std::memcpy(file_header.magic, MAGIC, sizeof(MAGIC));
+    file_header.version = VERSION;
+    file_header.column_count = static_cast<std::uint32_t>(headers.size());
+
+    file.write(reinterpret_cast<const char*>(&file_header), sizeof(file_header));
+    file.write(reinterpret_cast<const char*>(headers.data()), static_cast<std::streamsize>(sizeof(ColumnHeader) * headers.size()));
+
+    // Zero padding up to each block
+    const std::vector<char> padding(COLUMN_ALIGNMENT, 0);
+    size_t written = sizeof(FileHeader) + sizeof(ColumnHeader) * headers.size();
+    for (size_t i = 0; i < columns.size(); i++)
+    {
+        file.write(padding.data(), static_cast<std::streamsize>(headers[i].offset - written));
+        file.write(reinterpret_cast<const char*>(columns[i].data.data()), static_cast<std::streamsize>(columns[i].data.size()));
+        written = headers[i].offset + columns[i].data.size();
+    }
+
+    // The file ends aligned too, so a trailing empty column still starts inside it
+    file.write(padding.data(), static_cast<std::streamsize>(offset - written));
+
+    if (!file)
+    {
+        std::cerr << __FILE__ << ":" << __LINE__ << " Failed to write to file: " << path << std::endl;
+        return false;
+    }
+
+    return true;
+}
+
+const std::vector<ColumnarFile::Column>& ColumnarFile::GetColumns() const noexcept
+{
+    return m_columns;
+}
+
+std::optional<size_t> ColumnarFile::FindColumn(std::string_view name) const
+{
+    for (size_t i = 0; i < m_columns.size(); i++)
+    {
+        if (m_columns[i].name == name)
+        {
+            return i;
+        }
+    }
+
+    return std::nullopt;
+}
+
+std::span<const float> ColumnarFile::GetFloat32(size_t column) const
+{
+    const auto data = GetColumnData(column, ColumnType::eFloat32);
+    return { reinterpret_cast<const float*>(data.data()), data.size() / sizeof(float) };
+}
+
+std::span<const double> ColumnarFile::GetFloat64(size_t column) const
+{
+    const auto data = GetColumnData(column, ColumnType::eFloat64);
+    return { reinterpret_cast<const double*>(data.data()), data.size() / sizeof(double) };
+}
+
+std::span<const std::int64_t> ColumnarFile::GetInt64(size_t column) const
+{
+    const auto data = GetColumnData(column, ColumnType::eInt64);
+    return { reinterpret_cast<const std::int64_t*>(data.data()), data.size() / sizeof(std::int64_t) };
+}
+
+std::span<const Vertex> ColumnarFile::GetVertices(size_t column) const
+{
+    const auto data = GetColumnData(column, ColumnType::eVertex);
+    return { reinterpret_cast<const Vertex*>(data.data()), data.size() / sizeof(Vertex) };
+}
+
+void ColumnarFile::Prefetch(size_t column, size_t first, size_t count) const
+{
+    if (column >= m_columns.size())
+    {
+        return;
+    }
+
+    const auto& info = m_columns[column];
+    const size_t element_size = GetElementSize(static_cast<std::uint32_t>(info.type));
+
+    first = std::min(first, info.length);
+    count = std::min(count, info.length - first);
+    m_file.Prefetch(info.offset + first * element_size, count * element_size);
+}
+
+std::span<const std::byte> ColumnarFile::GetColumnData(size_t column, ColumnType type) const
+{
+    if (column >= m_columns.size() || m_columns[column].type != type)
+    {
+        return { };
+    }
+
+    const auto& info = m_columns[column];
+    return m_file.GetData().subspan(info.offset, info.length * GetElementSize(static_cast<std::uint32_t>(type)));
+}
@@ -0,0 +1,27 @@
+#include <Core/CpuFeatures.hpp>
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#include <immintrin.h>
+#endif
+
+bool gplot::core::IsAVX2Supported()
+{
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+    static const bool supported = []()
+    {
+        int info[4];
+        __cpuid(info, 1);
+        const bool os_saves_ymm = (info[2] & (1 << 27)) && (_xgetbv(0) & 0x6) == 0x6;
+
+        __cpuidex(info, 7, 0);
+        return os_saves_ymm && (info[1] & (1 << 5)) != 0;
+    }();
+
+    return supported;
+#elif defined(__x86_64__) || defined(__i386__)
+    return __builtin_cpu_supports("avx2");
+#else
+    return false;
+#endif
+}
@@ -0,0 +1,517 @@
+#include <Core/CsvFile.hpp>
+#include <Core/MappedFile.hpp>
+#include <Core/ThreadPool.hpp>
+#include <Core/CpuFeatures.hpp>
+
+#include <bit>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <charconv>
+#include <stdexcept>
+#include <algorithm>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define GPLOT_SCAN_X86
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#define GPLOT_TARGET_AVX2
+#else
+#define GPLOT_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#define GPLOT_SCAN_NEON
+#include <arm_neon.h>
+#endif
+
+using namespace gplot::core;
+
+namespace
+{
+    // Delimiters and newlines are located 64 bytes at a time, one mask bit per byte
+    constexpr size_t DELIMITER_BLOCK = 64;
+
+    using DelimiterKernel = std::uint64_t (*)(const char* block, char delimiter);
+
+    [[maybe_unused]] std::uint64_t FindDelimitersScalar(const char* block, char delimiter)
+    {
+        std::uint64_t mask = 0;
+        for (size_t i = 0; i < DELIMITER_BLOCK; i++)
+        {
+            mask |= static_cast<std::uint64_t>(block[i] == '\n' || block[i] == delimiter) << i;
+        }
+
+        return mask;
+    }
+
+#if defined(GPLOT_SCAN_X86)
+    GPLOT_TARGET_AVX2 std::uint64_t FindDelimitersAVX2(const char* block, char delimiter)
+    {
+        const __m256i newline = _mm256_set1_epi8('\n');
+        const __m256i separator = _mm256_set1_epi8(delimiter);
+
+        std::uint64_t mask = 0;
+        for (size_t half = 0; half < 2; half++)
+        {
+            const __m256i bytes = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(block + 32 * half));
+            const __m256i hits = _mm256_or_si256(_mm256_cmpeq_epi8(bytes, newline), _mm256_cmpeq_epi8(bytes, separator));
+            mask |= static_cast<std::uint64_t>(static_cast<std::uint32_t>(_mm256_movemask_epi8(hits))) << (32 * half);
+        }
+
+        return mask;
+    }
+
+    std::uint64_t FindDelimitersSSE2(const char* block, char delimiter)
+    {
+        const __m128i newline = _mm_set1_epi8('\n');
+        const __m128i separator = _mm_set1_epi8(delimiter);
+
+        std::uint64_t mask = 0;
+        for (size_t quarter = 0; quarter < 4; quarter++)
+        {
+            const __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(block + 16 * quarter));
+            const __m128i hits = _mm_or_si128(_mm_cmpeq_epi8(bytes, newline), _mm_cmpeq_epi8(bytes, separator));
+            mask |= static_cast<std::uint64_t>(_mm_movemask_epi8(hits)) << (16 * quarter);
+        }
+
+        return mask;
+    }
+#endif
+
+#if defined(GPLOT_SCAN_NEON)
+    // NEON has no movemask, every byte keeps its own bit and three pairwise adds fold 64 bytes into 64 bits
+    std::uint64_t FindDelimitersNEON(const char* block, char delimiter)
+    {
+        static constexpr std::uint8_t BITS[16] = { 1, 2, 4, 8, 16, 32, 64, 128, 1, 2, 4, 8, 16, 32, 64, 128 };
+
+        const uint8x16_t bits = vld1q_u8(BITS);
+        const uint8x16_t newline = vdupq_n_u8('\n');
+        const uint8x16_t separator = vdupq_n_u8(static_cast<std::uint8_t>(delimiter));
+
+        uint8x16_t hits[4];
+        for (size_t quarter = 0; quarter < 4; quarter++)
+        {
+            const uint8x16_t bytes = vld1q_u8(reinterpret_cast<const std::uint8_t*>(block + 16 * quarter));
+            hits[quarter] = vandq_u8(vorrq_u8(vceqq_u8(bytes, newline), vceqq_u8(bytes, separator)), bits);
+        }
+
+        uint8x16_t sum = vpaddq_u8(vpaddq_u8(hits[0], hits[1]), vpaddq_u8(hits[2], hits[3]));
+        sum = vpaddq_u8(sum, sum);
+
+        return vgetq_lane_u64(vreinterpretq_u64_u8(sum), 0);
+    }
+#endif
+
+    struct DelimiterKernelEntry
+    {
+        const char* name;
+        DelimiterKernel find;
+    };
+
+    const DelimiterKernelEntry& GetDelimiterKernel()
+    {
+        static const DelimiterKernelEntry kernel = []() -> DelimiterKernelEntry
+        {
+#if defined(GPLOT_SCAN_X86)
+            if (IsAVX2Supported())
+            {
+                return { "avx2", FindDelimitersAVX2 };
+            }
+            return { "sse2", FindDelimitersSSE2 };
+#elif defined(GPLOT_SCAN_NEON)
+            return { "neon", FindDelimitersNEON };
+#else
+            return { "scalar", FindDelimitersScalar };
+#endif
+        }();
+
+        return kernel;
+    }
+
+    // Drops surrounding blanks, the '\r' of CRLF line ends and a pair of quotes
+    std::string_view TrimField(std::string_view field)
+    {
+        const auto first = field.find_first_not_of(" \t\r");
+        if (first == std::string_view::npos)
+        {
+            return { };
+        }
+        field = field.substr(first, field.find_last_not_of(" \t\r") - first + 1);
+
+        if (field.size() >= 2 && field.front() == '"' && field.back() == '"')
+        {
+            field = field.substr(1, field.size() - 2);
+        }
+
+        return field;
+    }
+
+    // Clinger's fast path: a decimal mantissa below 2^53 scaled by an exact power of ten rounds correctly to double.
+    // Rounding that double to float is exact as well unless it lands right on the midpoint between two floats.
+    bool ParseDecimal(std::string_view field, float& value)
+    {
+        static constexpr double POWERS_OF_TEN[] =
+        {
+            1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+            1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22,
+        };
+        constexpr int MAX_EXACT_POWER = 22;
+        constexpr size_t MAX_DIGITS = 19;
+        constexpr std::uint64_t MAX_EXACT_MANTISSA = std::uint64_t(1) << 53;
+
+        const char* cursor = field.data();
+        const char* end = cursor + field.size();
+
+        const bool negative = cursor != end && *cursor == '-';
+        cursor += negative;
+
+        // Digits past MAX_DIGITS may wrap the mantissa, such numbers are left to from_chars anyway
+        std::uint64_t mantissa = 0;
+        const char* integer = cursor;
+        for (; cursor != end && static_cast<unsigned>(*cursor - '0') <= 9; cursor++)
+        {
+            mantissa = mantissa * 10 + static_cast<unsigned>(*cursor - '0');
+        }
+        size_t digits = static_cast<size_t>(cursor - integer);
+
+        int exponent = 0;
+        if (cursor != end && *cursor == '.')
+        {
+            const char* fraction = ++cursor;
+            for (; cursor != end && static_cast<unsigned>(*cursor - '0') <= 9; cursor++)
+            {
+                mantissa = mantissa * 10 + static_cast<unsigned>(*cursor - '0');
+            }
+            exponent = -static_cast<int>(cursor - fraction);
+            digits += static_cast<size_t>(cursor - fraction);
+        }
+
+        if (digits == 0 || digits > MAX_DIGITS)
+        {
+            return false;
+        }
+
+        if (cursor != end && (*cursor == 'e' || *cursor == 'E'))
+        {
+            cursor++;
+            const bool negative_exponent = cursor != end && *cursor == '-';
+            cursor += cursor != end && (*cursor == '-' || *cursor == '+');
+
+            int written = 0;
+            int digits_read = 0;
+            for (; cursor != end && static_cast<unsigned>(*cursor - '0') <= 9 && digits_read < 4; cursor++, digits_read++)
+            {
+                written = written * 10 + (*cursor - '0');
+            }
+            if (digits_read == 0)
+            {
+                return false;
+            }
+            exponent += negative_exponent ? -written : written;
+        }
+
+        if (cursor != end || mantissa > MAX_EXACT_MANTISSA || exponent < -MAX_EXACT_POWER || exponent > MAX_EXACT_POWER)
+        {
+            return false;
+        }
+
+        double result = static_cast<double>(mantissa);
+        result = exponent < 0 ? result / POWERS_OF_TEN[-exponent] : result * POWERS_OF_TEN[exponent];
+
+        // The 29 double mantissa bits below float precision reading 1000...0 mark a float midpoint
+        if ((std::bit_cast<std::uint64_t>(result) & 0x1FFFFFFF) == 0x10000000)
+        {
+            return false;
+        }
+
+        value = static_cast<float>(negative ? -result : result);
+        return true;
+    }
+
+    bool ParseNumber(std::string_view field, float& value)
+    {
+        field = TrimField(field);
+        if (!field.empty() && field.front() == '+')
+        {
+            field.remove_prefix(1);
+        }
+
+        if (ParseDecimal(field, value))
+        {
+            return true;
+        }
+
+        const char* end = field.data() + field.size();
+        const auto result = std::from_chars(field.data(), end, value);
+
+        return !field.empty() && result.ec == std::errc() && result.ptr == end;
+    }
+
+    std::vector<std::string_view> SplitLine(std::string_view line, char delimiter)
+    {
+        std::vector<std::string_view> fields;
+        for (size_t begin = 0;;)
+        {
+            const size_t end = std::min(line.find(delimiter, begin), line.size());
+            fields.push_back(TrimField(line.substr(begin, end - begin)));
+            if (end == line.size())
+            {
+                return fields;
+            }
+            begin = end + 1;
+        }
+    }
+
+    struct ChunkResult
+    {
+        std::vector<std::vector<float>> values;
+        std::vector<size_t> invalid;
+        size_t rows { 0 };
+    };
+
+    class ChunkParser
+    {
+    public:
+
+        ChunkParser(ChunkResult& result, size_t column_count) : m_result(result)
+        {
+            m_result.values.resize(column_count);
+            m_result.invalid.resize(column_count);
+        }
+
+        void Field(std::string_view field)
+        {
+            if (m_column < m_result.values.size())
+            {
+                float value;
+                if (!ParseNumber(field, value))
+                {
+                    value = std::numeric_limits<float>::quiet_NaN();
+                    m_result.invalid[m_column]++;
+                }
+                m_result.values[m_column].push_back(value);
+            }
+            m_column++;
+        }
+
+        void EndRow(std::string_view field)
+        {
+            if (m_column == 0 && TrimField(field).empty())
+            {
+                return;
+            }
+
+            Field(field);
+            for (; m_column < m_result.values.size(); m_column++)
+            {
+                m_result.values[m_column].push_back(std::numeric_limits<float>::quiet_NaN());
+                m_result.invalid[m_column]++;
+            }
+
+            m_column = 0;
+            m_result.rows++;
+        }
+
+        [[nodiscard]] bool IsInsideRow() const noexcept
+        {
+            return m_column > 0;
+        }
+
+    private:
+
+        ChunkResult& m_result;
+        size_t m_column { 0 };
+    };
+
+    void ParseChunk(std::string_view text, char delimiter, DelimiterKernel find, ChunkParser& parser)
+    {
+        const char* data = text.data();
+
+        size_t field = 0;
+        for (size_t block = 0; block < text.size(); block += DELIMITER_BLOCK)
+        {
+            const size_t length = std::min(DELIMITER_BLOCK, text.size() - block);
+
+            std::uint64_t mask;
+            if (length == DELIMITER_BLOCK)
+            {
+                mask = find(data + block, delimiter);
+            }
+            else
+            {
+                // The last block is copied out, the kernels always read a full block
+                char tail[DELIMITER_BLOCK] = { };
+                std::memcpy(tail, data + block, length);
+                mask = find(tail, delimiter) & ((std::uint64_t(1) << length) - 1);
+            }
+
+            while (mask)
+            {
+                const size_t position = block + static_cast<size_t>(std::countr_zero(mask));
+                mask &= mask - 1;
+
+                const std::string_view value(data + field, position - field);
+                if (data[position] == '\n')
+                {
+                    parser.EndRow(value);
+                }
+                else
+                {
+                    parser.Field(value);
+                }
+                field = position + 1;
+            }
+        }
+
+        // Only the last chunk can end without a newline
+        if (field < text.size() || parser.IsInsideRow())
+        {
+            parser.EndRow(text.substr(field));
+        }
+    }
+}
+
+CsvFile::CsvFile(std::string_view path, const CsvFileDescriptor& descriptor)
+{
+    const MappedFile file(path);
+    const auto data = file.GetData();
+
+    Parse(std::string_view(reinterpret_cast<const char*>(data.data()), data.size()), descriptor);
+}
+
+void CsvFile::Parse(std::string_view text, const CsvFileDescriptor& descriptor)
+{
+    // UTF-8 byte order mark
+    if (text.starts_with("\xEF\xBB\xBF"))
+    {
+        text.remove_prefix(3);
+    }
+
+    const size_t line_end = std::min(text.find('\n'), text.size());
+    const auto first_line = SplitLine(text.substr(0, line_end), descriptor.delimiter);
+    if (first_line.size() == 1 && first_line.front().empty())
+    {
+        throw std::runtime_error("Delimited file has no columns");
+    }
+
+    m_columns.resize(first_line.size());
+    for (size_t i = 0; i < m_columns.size(); i++)
+    {
+        m_columns[i].name = descriptor.has_header ? std::string(first_line[i]) : std::to_string(i);
+    }
+
+    if (descriptor.has_header)
+    {
+        text.remove_prefix(std::min(line_end + 1, text.size()));
+    }
+
+    // Chunks end after a newline, so every row is parsed by exactly one task
+    std::vector<size_t> bounds { 0 };
+    const size_t chunk_size = std::max<size_t>(descriptor.chunk_size, 1);
+    while (bounds.back() < text.size())
+    {
+        const size_t target = bounds.back() + chunk_size;
+        const size_t newline = target < text.size() ? text.find('\n', target - 1) : std::string_view::npos;
+        bounds.push_back(newline == std::string_view::npos ? text.size() : newline + 1);
+    }
+
+    const auto find = GetDelimiterKernel().find;
+
+    std::vector<ChunkResult> chunks(bounds.size() - 1);
+    ThreadPool::GetDefault().ParallelFor(chunks.size(), 1, [&](size_t begin, size_t end)
+    {
+        for (size_t chunk = begin; chunk < end; chunk++)
+        {
+            ChunkParser parser(chunks[chunk], m_columns.size());
+            ParseChunk(text.substr(bounds[chunk], bounds[chunk + 1] - bounds[chunk]), descriptor.delimiter, find, parser);
+        }
+    });
+
+    std::vector<size_t> offsets(chunks.size());
+    for (size_t chunk = 0; chunk < chunks.size(); chunk++)
+    {
+        offsets[chunk] = m_row_count;
+        m_row_count += chunks[chunk].rows;
+
+        for (size_t column = 0; column < m_columns.size(); column++)
+        {
+            m_columns[column].invalid_count += chunks[chunk].invalid[column];
+        }
+    }
+
+    for (auto& column : m_columns)
+    {
+        column.values.resize(m_row_count);
+    }
+
+    ThreadPool::GetDefault().ParallelFor(chunks.size(), 1, [&](size_t begin, size_t end)
+    {
+        for (size_t chunk = begin; chunk < end; chunk++)
+        {
+            for (size_t column = 0; column < m_columns.size(); column++)
+            {
+                auto& values = chunks[chunk].values[column];
+                std::copy(values.begin(), values.end(), m_columns[column].values.begin() + static_cast<std::ptrdiff_t>(offsets[chunk]));
+
+                values = { };
+            }
+        }
+    });
+}
+
+const std::vector<CsvFile::Column>& CsvFile::GetColumns() const noexcept
+{
+    return m_columns;
+}
+
+size_t CsvFile::GetRowCount() const noexcept
+{
+    return m_row_count;
+}
+
+std::optional<size_t> CsvFile::FindColumn(std::string_view name) const
+{
+    for (size_t i = 0; i < m_columns.size(); i++)
+    {
+        if (m_columns[i].name == name)
+        {
+            return i;
+        }
+    }
+
+    return std::nullopt;
+}
+
+std::span<const float> CsvFile::GetValues(size_t column) const
+{
+    if (column >= m_columns.size())
+    {
+        return { };
+    }
+
+    return m_columns[column].values;
+}
+
+std::vector<Vertex> CsvFile::GetVertices(size_t x_column, size_t y_column) const
+{
+    if (x_column >= m_columns.size() || y_column >= m_columns.size())
+    {
+        return { };
+    }
+
+    const auto& x = m_columns[x_column].values;
+    const auto& y = m_columns[y_column].values;
+
+    std::vector<Vertex> vertices(m_row_count);
+    for (size_t i = 0; i < m_row_count; i++)
+    {
+        vertices[i].pos = { x[i], y[i] };
+    }
+
+    return vertices;
+}
+
+const char* CsvFile::GetDelimiterKernelName()
+{
+    return GetDelimiterKernel().name;
+}
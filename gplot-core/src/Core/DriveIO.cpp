@@ -1,67 +1,170 @@
 #include <Core/DriveIO.hpp>
+#include <Core/ThreadPool.hpp>
 
+#include <atomic>
+#include <memory>
 #include <fstream>
+#include <filesystem>
 #include <iostream>
+#include <algorithm>
 
 using namespace gplot::core;
 
+namespace
+{
+    // Enough requests in flight to overlap disk latency, independent of the core count
+    constexpr size_t IO_THREAD_COUNT = 4;
+}
+
 DriveIO::file_data DriveIO::Read(std::string_view path)
 {
-    return ReadAsync(path).get();
+    return ReadFile(path);
 }
 
 std::future<DriveIO::file_data> DriveIO::ReadAsync(std::string_view path)
 {
-    return std::async(std::launch::async, [path]()
+    return GetPool().Submit([path = std::string(path)]()
     {
-        return DriveIO::ReadFile(path);
+        return ReadFile(path);
+    });
+}
+
+void DriveIO::ReadAsync(std::string_view path, ReadCallback on_read)
+{
+    GetPool().Submit([path = std::string(path), on_read = std::move(on_read)]()
+    {
+        on_read(ReadFile(path));
     });
 }
 
 bool DriveIO::Write(std::string_view path, const file_data& data)
 {
-    return WriteAsync(path, data).get();
+    return WriteFile(path, data);
 }
 
-std::future<bool> DriveIO::WriteAsync(std::string_view path, const gplot::core::DriveIO::file_data& data)
+std::future<bool> DriveIO::WriteAsync(std::string_view path, file_data data)
 {
-    return std::async(std::launch::async, [path, data]()
+    return GetPool().Submit([path = std::string(path), data = std::move(data)]()
     {
-        return DriveIO::WriteFile(path, data);
+        return WriteFile(path, data);
     });
 }
 
+void DriveIO::WriteAsync(std::string_view path, file_data data, WriteCallback on_written)
+{
+    GetPool().Submit([path = std::string(path), data = std::move(data), on_written = std::move(on_written)]()
+    {
+        on_written(WriteFile(path, data));
+    });
+}
+
+std::vector<DriveIO::file_data> DriveIO::ReadBatch(std::vector<std::string> paths)
+{
+    std::vector<file_data> result(paths.size());
+    ReadBatchAsync(std::move(paths), [&result](size_t index, file_data data)
+    {
+        result[index] = std::move(data);
+    }).wait();
+
+    return result;
+}
+
+std::future<void> DriveIO::ReadBatchAsync(std::vector<std::string> paths, BatchReadCallback on_read)
+{
+    struct State
+    {
+        std::vector<std::string> paths;
+        BatchReadCallback on_read;
+        std::atomic<size_t> next { 0 };
+        std::atomic<size_t> remaining { 0 };
+        std::promise<void> done;
+    };
+
+    auto state = std::make_shared<State>();
+    state->paths = std::move(paths);
+    state->on_read = std::move(on_read);
+    state->remaining = state->paths.size();
+
+    auto future = state->done.get_future();
+    if (state->paths.empty())
+    {
+        state->done.set_value();
+        return future;
+    }
+
+    // One task per I/O thread claims files until none are left, so a large batch does not flood the queue
+    const size_t runners = std::min(state->paths.size(), GetPool().GetThreadCount());
+    for (size_t i = 0; i < runners; i++)
+    {
+        GetPool().Submit([state]()
+        {
+            for (size_t index = state->next++; index < state->paths.size(); index = state->next++)
+            {
+                state->on_read(index, ReadFile(state->paths[index]));
+
+                if (--state->remaining == 0)
+                {
+                    state->done.set_value();
+                }
+            }
+        });
+    }
+
+    return future;
+}
+
+size_t DriveIO::GetThreadCount()
+{
+    return GetPool().GetThreadCount();
+}
+
+ThreadPool& DriveIO::GetPool()
+{
+    // Separate from ThreadPool::GetDefault, blocking I/O would stall the compute tasks queued there.
+    // ThreadPool keeps one thread back for the ParallelFor caller, I/O requests have no such caller.
+    static ThreadPool pool(IO_THREAD_COUNT + 1);
+    return pool;
+}
+
 DriveIO::file_data DriveIO::ReadFile(std::string_view path)
 {
-    std::ifstream file(path.data(), std::ios::binary | std::ios::ate);
-    if (!file.is_open())
+    // Directories open as streams on some platforms and report a bogus size
+    std::error_code error;
+    std::ifstream file(std::string(path), std::ios::binary | std::ios::ate);
+    if (!file.is_open() || std::filesystem::is_directory(path, error))
     {
-        std::cerr << __FILE__ << __LINE__ << "Failed to open file: " << path << std::endl;
+        std::cerr << __FILE__ << ":" << __LINE__ << " Failed to open file: " << path << std::endl;
         return { };
     }
 
-    std::streamsize size = file.tellg();
+    // Pipes and other unseekable files have no size
+    const std::streamsize size = file.tellg();
+    if (size < 0)
+    {
+        std::cerr << __FILE__ << ":" << __LINE__ << " Failed to get file size: " << path << std::endl;
+        return { };
+    }
     file.seekg(0, std::ios::beg);
 
-    std::vector<char> buffer(size);
+    // Room for the terminating NUL up front, appending it could reallocate and copy the whole file
+    std::vector<char> buffer(static_cast<size_t>(size) + 1, '\0');
     if (file.read(buffer.data(), size))
     {
-        buffer.emplace_back('\0');
         return buffer;
     }
     else
     {
-        std::cerr << __FILE__ << __LINE__ << "Failed to read file: " << path << std::endl;
+        std::cerr << __FILE__ << ":" << __LINE__ << " Failed to read file: " << path << std::endl;
         return { };
     }
 }
 
-bool DriveIO::WriteFile(std::string_view path, const gplot::core::DriveIO::file_data& data)
+bool DriveIO::WriteFile(std::string_view path, const file_data& data)
 {
-    std::ofstream file(path.data(), std::ios::binary);
+    std::ofstream file(std::string(path), std::ios::binary);
     if (!file.is_open())
     {
-        std::cerr << __FILE__ << __LINE__ << "Failed to open file: " << path << std::endl;
+        std::cerr << __FILE__ << ":" << __LINE__ << " Failed to open file: " << path << std::endl;
         return false;
     }
 
@@ -70,6 +173,6 @@ bool DriveIO::WriteFile(std::string_view path, const gplot::core::DriveIO::file_
         return true;
     }
 
-    std::cerr << __FILE__ << __LINE__ << "Failed to write to file: " << path << std::endl;
+    std::cerr << __FILE__ << ":" << __LINE__ << " Failed to write to file: " << path << std::endl;
     return false;
 }
@@ -0,0 +1,152 @@
+#include <Core/Image.hpp>
+#include <Core/DriveIO.hpp>
+
+#include <array>
+#include <algorithm>
+#include <cstring>
+
+#ifdef GPLOT_HAS_ZLIB
+#include <zlib.h>
+#endif
+
+using namespace gplot::core;
+
+namespace
+{
+    // Largest payload of a stored deflate block
+    constexpr size_t STORED_BLOCK_SIZE = 65535;
+
+    std::uint32_t Crc32(const std::uint8_t* data, size_t size, std::uint32_t crc = 0)
+    {
+        static const auto table = []()
+        {
+            std::array<std::uint32_t, 256> result { };
+            for (std::uint32_t i = 0; i < 256; i++)
+            {
+                std::uint32_t value = i;
+                for (int bit = 0; bit < 8; bit++)
+                {
+                    value = (value & 1) ? 0xEDB88320U ^ (value >> 1) : value >> 1;
+                }
+                result[i] = value;
+            }
+
+            return result;
+        }();
+
+        crc = ~crc;
+        for (size_t i = 0; i < size; i++)
+        {
+            crc = table[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+        }
+
+        return ~crc;
+    }
+
+    void PutUInt32(std::vector<std::uint8_t>& output, std::uint32_t value)
+    {
+        output.push_back(static_cast<std::uint8_t>(value >> 24));
+        output.push_back(static_cast<std::uint8_t>(value >> 16));
+        output.push_back(static_cast<std::uint8_t>(value >> 8));
+        output.push_back(static_cast<std::uint8_t>(value));
+    }
+
+    void PutChunk(std::vector<std::uint8_t>& output, const char* type, const std::uint8_t* data, size_t size)
+    {
+        PutUInt32(output, static_cast<std::uint32_t>(size));
+
+        const size_t start = output.size();
+        output.insert(output.end(), type, type + 4);
+        output.insert(output.end(), data, data + size);
+
+        PutUInt32(output, Crc32(output.data() + start, size + 4));
+    }
+
+    std::vector<std::uint8_t> Deflate(const std::vector<std::uint8_t>& raw)
+    {
+#ifdef GPLOT_HAS_ZLIB
+        uLongf size = compressBound(static_cast<uLong>(raw.size()));
+        std::vector<std::uint8_t> compressed(size);
+        if (compress2(compressed.data(), &size, raw.data(), static_cast<uLong>(raw.size()), Z_BEST_SPEED) == Z_OK)
+        {
+            compressed.resize(size);
+            return compressed;
+        }
+#endif
+
+        // zlib stream made of stored blocks
+        std::vector<std::uint8_t> output = { 0x78, 0x01 };
+        output.reserve(raw.size() + raw.size() / STORED_BLOCK_SIZE * 5 + 16);
+
+        size_t offset = 0;
+        do
+        {
+            const size_t size = std::min(STORED_BLOCK_SIZE, raw.size() - offset);
+            const bool last = offset + size == raw.size();
+
+            output.push_back(last ? 1 : 0);
+            output.push_back(static_cast<std::uint8_t>(size));
+            output.push_back(static_cast<std::uint8_t>(size >> 8));
+            output.push_back(static_cast<std::uint8_t>(~size));
+            output.push_back(static_cast<std::uint8_t>(~size >> 8));
+            output.insert(output.end(), raw.begin() + static_cast<std::ptrdiff_t>(offset), raw.begin() + static_cast<std::ptrdiff_t>(offset + size));
+
+            offset += size;
+        } while (offset < raw.size());
+
+        std::uint32_t a = 1;
+        std::uint32_t b = 0;
+        for (const auto byte : raw)
+        {
+            a = (a + byte) % 65521;
+            b = (b + a) % 65521;
+        }
+        PutUInt32(output, (b << 16) | a);
+
+        return output;
+    }
+}
+
+std::vector<std::uint8_t> gplot::core::EncodePNG(const std::uint8_t* rgba, int width, int height)
+{
+    const size_t row_size = static_cast<size_t>(width) * 4;
+
+    // Every scanline is prefixed with its filter type, 0 = none
+    std::vector<std::uint8_t> raw((row_size + 1) * height);
+    for (int y = 0; y < height; y++)
+    {
+        raw[(row_size + 1) * y] = 0;
+        std::memcpy(raw.data() + (row_size + 1) * y + 1, rgba + row_size * y, row_size);
+    }
+
+    std::vector<std::uint8_t> output = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n' };
+
+    std::vector<std::uint8_t> header;
+    PutUInt32(header, static_cast<std::uint32_t>(width));
+    PutUInt32(header, static_cast<std::uint32_t>(height));
+    header.insert(header.end(), { 8, 6, 0, 0, 0 }); // 8 bits per channel, RGBA, deflate, adaptive filtering, no interlace
+
+    PutChunk(output, "IHDR", header.data(), header.size());
+
+    const auto compressed = Deflate(raw);
+    PutChunk(output, "IDAT", compressed.data(), compressed.size());
+    PutChunk(output, "IEND", nullptr, 0);
+
+    return output;
+}
+
+bool gplot::core::WritePNG(std::string_view path, const std::uint8_t* rgba, int width, int height)
+{
+    const auto encoded = EncodePNG(rgba, width, height);
+
+    DriveIO disk_io;
+    return disk_io.Write(path, DriveIO::file_data(encoded.begin(), encoded.end()));
+}
+
+void gplot::core::FlipRows(std::uint8_t* pixels, size_t row_size, int height)
+{
+    for (int y = 0; y < height / 2; y++)
+    {
+        std::swap_ranges(pixels + row_size * y, pixels + row_size * (y + 1), pixels + row_size * (height - 1 - y));
+    }
+}
@@ -0,0 +1,146 @@
+#include <Core/MappedFile.hpp>
+
+#include <string>
+#include <stdexcept>
+#include <algorithm>
+
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+using namespace gplot::core;
+
+#if defined(_WIN32)
+
+MappedFile::MappedFile(std::string_view path)
+{
+    const std::string file_path(path);
+
+    m_file = CreateFileA(file_path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (m_file == INVALID_HANDLE_VALUE)
+    {
+        throw std::runtime_error("Failed to open file for mapping: " + file_path);
+    }
+
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(m_file, &size))
+    {
+        CloseHandle(m_file);
+        throw std::runtime_error("Failed to query file size: " + file_path);
+    }
+    m_size = static_cast<size_t>(size.QuadPart);
+
+    // Empty files cannot be mapped, they stay an empty view
+    if (m_size == 0)
+    {
+        return;
+    }
+
+    m_mapping = CreateFileMappingA(m_file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    m_data = m_mapping ? static_cast<const std::byte*>(MapViewOfFile(m_mapping, FILE_MAP_READ, 0, 0, 0)) : nullptr;
+    if (!m_data)
+    {
+        if (m_mapping)
+        {
+            CloseHandle(m_mapping);
+        }
+        CloseHandle(m_file);
+        throw std::runtime_error("Failed to map file: " + file_path);
+    }
+}
+
+MappedFile::~MappedFile() noexcept
+{
+    if (m_data)
+    {
+        UnmapViewOfFile(m_data);
+        CloseHandle(m_mapping);
+    }
+    CloseHandle(m_file);
+}
+
+void MappedFile::Prefetch(size_t offset, size_t size) const
+{
+    if (offset >= m_size)
+    {
+        return;
+    }
+
+    WIN32_MEMORY_RANGE_ENTRY range { const_cast<std::byte*>(m_data) + offset, std::min(size, m_size - offset) };
+    PrefetchVirtualMemory(GetCurrentProcess(), 1, &range, 0);
+}
+
+#else
+
+MappedFile::MappedFile(std::string_view path)
+{
+    const std::string file_path(path);
+
+    const int file = open(file_path.c_str(), O_RDONLY);
+    if (file < 0)
+    {
+        throw std::runtime_error("Failed to open file for mapping: " + file_path);
+    }
+
+    struct stat status { };
+    if (fstat(file, &status) != 0)
+    {
+        close(file);
+        throw std::runtime_error("Failed to query file size: " + file_path);
+    }
+    m_size = static_cast<size_t>(status.st_size);
+
+    // Empty files cannot be mapped, they stay an empty view. The mapping outlives the descriptor.
+    if (m_size > 0)
+    {
+        void* data = mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, file, 0);
+        if (data == MAP_FAILED)
+        {
+            close(file);
+            throw std::runtime_error("Failed to map file: " + file_path);
+        }
+        m_data = static_cast<const std::byte*>(data);
+    }
+
+    close(file);
+}
+
+MappedFile::~MappedFile() noexcept
+{
+    if (m_data)
+    {
+        munmap(const_cast<std::byte*>(m_data), m_size);
+    }
+}
+
+void MappedFile::Prefetch(size_t offset, size_t size) const
+{
+    if (offset >= m_size)
+    {
+        return;
+    }
+
+    // madvise wants a page-aligned start
+    const auto page = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    const size_t begin = offset / page * page;
+    madvise(const_cast<std::byte*>(m_data) + begin, std::min(size, m_size - offset) + offset - begin, MADV_WILLNEED);
+}
+
+#endif
+
+std::span<const std::byte> MappedFile::GetData() const noexcept
+{
+    return { m_data, m_size };
+}
+
+size_t MappedFile::GetSize() const noexcept
+{
+    return m_size;
+}
@@ -0,0 +1,314 @@
+#include <Core/Math.hpp>
+#include <Core/ThreadPool.hpp>
+#include <Core/CpuFeatures.hpp>
+
+#include <cmath>
+#include <mutex>
+#include <bit>
+#include <algorithm>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define GPLOT_SCAN_X86
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#define GPLOT_TARGET_AVX2
+#else
+#define GPLOT_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#define GPLOT_SCAN_NEON
+#include <arm_neon.h>
+#endif
+
+using namespace gplot::core;
+
+namespace
+{
+    // Every kernel keeps eight running lanes, so interleaved vertices put x in the even lanes and y in the odd ones
+    constexpr size_t SCAN_LANES = 8;
+
+    // Arrays from this many floats on are split over the default thread pool
+    constexpr size_t PARALLEL_SCAN_VALUES = 1 << 23;
+    constexpr size_t PARALLEL_SCAN_GRAIN = 1 << 21;
+
+    struct LaneRange
+    {
+        float min[SCAN_LANES];
+        float max[SCAN_LANES];
+        float finite_min[SCAN_LANES];
+        float finite_max[SCAN_LANES];
+        size_t nan_count { 0 };
+
+        LaneRange()
+        {
+            std::fill(std::begin(min), std::end(min), std::numeric_limits<float>::max());
+            std::fill(std::begin(max), std::end(max), std::numeric_limits<float>::lowest());
+            std::fill(std::begin(finite_min), std::end(finite_min), std::numeric_limits<float>::max());
+            std::fill(std::begin(finite_max), std::end(finite_max), std::numeric_limits<float>::lowest());
+        }
+    };
+
+    // `pairs` counts NaNs per vertex instead of per value, `count` has to be even then
+    using ScanKernel = void (*)(const float* values, size_t count, bool pairs, LaneRange& range);
+
+    void ScanScalar(const float* values, size_t count, bool pairs, LaneRange& range)
+    {
+        for (size_t i = 0; i < count; i++)
+        {
+            const float value = values[i];
+            const size_t lane = i % SCAN_LANES;
+            if (std::isnan(value))
+            {
+                // A vertex with two NaN coordinates is counted at its x
+                range.nan_count += !pairs || i % 2 == 0 || !std::isnan(values[i - 1]);
+                continue;
+            }
+
+            range.min[lane] = std::min(range.min[lane], value);
+            range.max[lane] = std::max(range.max[lane], value);
+            if (std::isfinite(value))
+            {
+                range.finite_min[lane] = std::min(range.finite_min[lane], value);
+                range.finite_max[lane] = std::max(range.finite_max[lane], value);
+            }
+        }
+    }
+
+#if defined(GPLOT_SCAN_X86)
+    int CountNaNs(int mask, bool pairs)
+    {
+        return std::popcount(static_cast<unsigned>(pairs ? (mask | mask >> 1) & 0x55 : mask));
+    }
+
+    // min/max return their second operand when either one is NaN, so NaN values leave the accumulators alone
+    GPLOT_TARGET_AVX2 void ScanAVX2(const float* values, size_t count, bool pairs, LaneRange& range)
+    {
+        const __m256 abs_mask = _mm256_castsi256_ps(_mm256_set1_epi32(0x7FFFFFFF));
+        const __m256 infinity = _mm256_set1_ps(std::numeric_limits<float>::infinity());
+        const __m256 highest = _mm256_set1_ps(std::numeric_limits<float>::max());
+        const __m256 lowest = _mm256_set1_ps(std::numeric_limits<float>::lowest());
+
+        __m256 min = _mm256_loadu_ps(range.min);
+        __m256 max = _mm256_loadu_ps(range.max);
+        __m256 finite_min = _mm256_loadu_ps(range.finite_min);
+        __m256 finite_max = _mm256_loadu_ps(range.finite_max);
+
+        size_t i = 0;
+        for (; i + SCAN_LANES <= count; i += SCAN_LANES)
+        {
+            const __m256 value = _mm256_loadu_ps(values + i);
+            min = _mm256_min_ps(value, min);
+            max = _mm256_max_ps(value, max);
+
+            const __m256 finite = _mm256_cmp_ps(_mm256_and_ps(value, abs_mask), infinity, _CMP_LT_OQ);
+            finite_min = _mm256_min_ps(_mm256_blendv_ps(highest, value, finite), finite_min);
+            finite_max = _mm256_max_ps(_mm256_blendv_ps(lowest, value, finite), finite_max);
+
+            range.nan_count += CountNaNs(_mm256_movemask_ps(_mm256_cmp_ps(value, value, _CMP_UNORD_Q)), pairs);
+        }
+
+        _mm256_storeu_ps(range.min, min);
+        _mm256_storeu_ps(range.max, max);
+        _mm256_storeu_ps(range.finite_min, finite_min);
+        _mm256_storeu_ps(range.finite_max, finite_max);
+
+        ScanScalar(values + i, count - i, pairs, range);
+    }
+
+    // Two registers cover the eight lanes, SSE2 has no blend so the finite mask selects with and/andnot
+    void ScanSSE2(const float* values, size_t count, bool pairs, LaneRange& range)
+    {
+        const __m128 abs_mask = _mm_castsi128_ps(_mm_set1_epi32(0x7FFFFFFF));
+        const __m128 infinity = _mm_set1_ps(std::numeric_limits<float>::infinity());
+        const __m128 highest = _mm_set1_ps(std::numeric_limits<float>::max());
+        const __m128 lowest = _mm_set1_ps(std::numeric_limits<float>::lowest());
+
+        __m128 min[2] = { _mm_loadu_ps(range.min), _mm_loadu_ps(range.min + 4) };
+        __m128 max[2] = { _mm_loadu_ps(range.max), _mm_loadu_ps(range.max + 4) };
+        __m128 finite_min[2] = { _mm_loadu_ps(range.finite_min), _mm_loadu_ps(range.finite_min + 4) };
+        __m128 finite_max[2] = { _mm_loadu_ps(range.finite_max), _mm_loadu_ps(range.finite_max + 4) };
+
+        size_t i = 0;
+        for (; i + SCAN_LANES <= count; i += SCAN_LANES)
+        {
+            int nan_mask = 0;
+            for (int half = 0; half < 2; half++)
+            {
+                const __m128 value = _mm_loadu_ps(values + i + 4 * half);
+                min[half] = _mm_min_ps(value, min[half]);
+                max[half] = _mm_max_ps(value, max[half]);
+
+                const __m128 finite = _mm_cmplt_ps(_mm_and_ps(value, abs_mask), infinity);
+                finite_min[half] = _mm_min_ps(_mm_or_ps(_mm_and_ps(finite, value), _mm_andnot_ps(finite, highest)), finite_min[half]);
+                finite_max[half] = _mm_max_ps(_mm_or_ps(_mm_and_ps(finite, value), _mm_andnot_ps(finite, lowest)), finite_max[half]);
+
+                nan_mask |= _mm_movemask_ps(_mm_cmpunord_ps(value, value)) << (4 * half);
+            }
+
+            range.nan_count += CountNaNs(nan_mask, pairs);
+        }
+
+        for (int half = 0; half < 2; half++)
+        {
+            _mm_storeu_ps(range.min + 4 * half, min[half]);
+            _mm_storeu_ps(range.max + 4 * half, max[half]);
+            _mm_storeu_ps(range.finite_min + 4 * half, finite_min[half]);
+            _mm_storeu_ps(range.finite_max + 4 * half, finite_max[half]);
+        }
+
+        ScanScalar(values + i, count - i, pairs, range);
+    }
+#endif
+
+#if defined(GPLOT_SCAN_NEON)
+    // vminnm/vmaxnm return the number when one operand is NaN
+    void ScanNEON(const float* values, size_t count, bool pairs, LaneRange& range)
+    {
+        const float32x4_t infinity = vdupq_n_f32(std::numeric_limits<float>::infinity());
+        const float32x4_t highest = vdupq_n_f32(std::numeric_limits<float>::max());
+        const float32x4_t lowest = vdupq_n_f32(std::numeric_limits<float>::lowest());
+
+        float32x4_t min[2] = { vld1q_f32(range.min), vld1q_f32(range.min + 4) };
+        float32x4_t max[2] = { vld1q_f32(range.max), vld1q_f32(range.max + 4) };
+        float32x4_t finite_min[2] = { vld1q_f32(range.finite_min), vld1q_f32(range.finite_min + 4) };
+        float32x4_t finite_max[2] = { vld1q_f32(range.finite_max), vld1q_f32(range.finite_max + 4) };
+
+        size_t i = 0;
+        for (; i + SCAN_LANES <= count; i += SCAN_LANES)
+        {
+            for (int half = 0; half < 2; half++)
+            {
+                const float32x4_t value = vld1q_f32(values + i + 4 * half);
+                min[half] = vminnmq_f32(value, min[half]);
+                max[half] = vmaxnmq_f32(value, max[half]);
+
+                const uint32x4_t finite = vcltq_f32(vabsq_f32(value), infinity);
+                finite_min[half] = vminq_f32(vbslq_f32(finite, value, highest), finite_min[half]);
+                finite_max[half] = vmaxq_f32(vbslq_f32(finite, value, lowest), finite_max[half]);
+
+                // Both lanes of a NaN vertex end up set, so vertices are counted twice and halved
+                uint32x4_t nan = vmvnq_u32(vceqq_f32(value, value));
+                nan = pairs ? vorrq_u32(nan, vrev64q_u32(nan)) : nan;
+                const uint32_t lanes = vaddvq_u32(vshrq_n_u32(nan, 31));
+                range.nan_count += pairs ? lanes / 2 : lanes;
+            }
+        }
+
+        for (int half = 0; half < 2; half++)
+        {
+            vst1q_f32(range.min + 4 * half, min[half]);
+            vst1q_f32(range.max + 4 * half, max[half]);
+            vst1q_f32(range.finite_min + 4 * half, finite_min[half]);
+            vst1q_f32(range.finite_max + 4 * half, finite_max[half]);
+        }
+
+        ScanScalar(values + i, count - i, pairs, range);
+    }
+#endif
+
+    struct ScanKernelEntry
+    {
+        const char* name;
+        ScanKernel scan;
+    };
+
+    const ScanKernelEntry& GetScanKernel()
+    {
+        static const ScanKernelEntry kernel = []() -> ScanKernelEntry
+        {
+#if defined(GPLOT_SCAN_X86)
+            if (IsAVX2Supported())
+            {
+                return { "avx2", ScanAVX2 };
+            }
+            return { "sse2", ScanSSE2 };
+#elif defined(GPLOT_SCAN_NEON)
+            return { "neon", ScanNEON };
+#else
+            return { "scalar", ScanScalar };
+#endif
+        }();
+
+        return kernel;
+    }
+
+    void MergeLanes(LaneRange& target, const LaneRange& source)
+    {
+        for (size_t lane = 0; lane < SCAN_LANES; lane++)
+        {
+            target.min[lane] = std::min(target.min[lane], source.min[lane]);
+            target.max[lane] = std::max(target.max[lane], source.max[lane]);
+            target.finite_min[lane] = std::min(target.finite_min[lane], source.finite_min[lane]);
+            target.finite_max[lane] = std::max(target.finite_max[lane], source.finite_max[lane]);
+        }
+        target.nan_count += source.nan_count;
+    }
+
+    // `stride` floats make one element, parallel chunks therefore start on element boundaries
+    LaneRange ScanLanes(const float* values, size_t count, size_t stride)
+    {
+        const auto scan = GetScanKernel().scan;
+        const bool pairs = stride == 2;
+
+        LaneRange result;
+        if (count < PARALLEL_SCAN_VALUES)
+        {
+            scan(values, count, pairs, result);
+            return result;
+        }
+
+        std::mutex mutex;
+        ThreadPool::GetDefault().ParallelFor(count / stride, PARALLEL_SCAN_GRAIN / stride, [&](size_t begin, size_t end)
+        {
+            LaneRange partial;
+            scan(values + begin * stride, (end - begin) * stride, pairs, partial);
+
+            const std::lock_guard lock(mutex);
+            MergeLanes(result, partial);
+        });
+
+        return result;
+    }
+}
+
+DataRange gplot::core::ScanDataRange(std::span<const Vertex> vertices)
+{
+    static_assert(sizeof(Vertex) == 2 * sizeof(float), "ScanDataRange reads vertices as interleaved floats");
+
+    const auto lanes = ScanLanes(reinterpret_cast<const float*>(vertices.data()), 2 * vertices.size(), 2);
+
+    DataRange range;
+    for (size_t lane = 0; lane < SCAN_LANES; lane++)
+    {
+        const auto axis = static_cast<glm::length_t>(lane % 2);
+        range.bounds.min[axis] = std::min(range.bounds.min[axis], lanes.min[lane]);
+        range.bounds.max[axis] = std::max(range.bounds.max[axis], lanes.max[lane]);
+        range.finite.min[axis] = std::min(range.finite.min[axis], lanes.finite_min[lane]);
+        range.finite.max[axis] = std::max(range.finite.max[axis], lanes.finite_max[lane]);
+    }
+    range.nan_count = lanes.nan_count;
+
+    return range;
+}
+
+ValueRange gplot::core::ScanValueRange(std::span<const float> values)
+{
+    const auto lanes = ScanLanes(values.data(), values.size(), 1);
+
+    ValueRange range;
+    for (size_t lane = 0; lane < SCAN_LANES; lane++)
+    {
+        range.min = std::min(range.min, lanes.min[lane]);
+        range.max = std::max(range.max, lanes.max[lane]);
+        range.finite_min = std::min(range.finite_min, lanes.finite_min[lane]);
+        range.finite_max = std::max(range.finite_max, lanes.finite_max[lane]);
+    }
+    range.nan_count = lanes.nan_count;
+
+    return range;
+}
+
+const char* gplot::core::GetScanKernelName()
+{
+    return GetScanKernel().name;
+}
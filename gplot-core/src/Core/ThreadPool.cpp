@@ -0,0 +1,128 @@
+#include <Core/ThreadPool.hpp>
+
+#include <atomic>
+#include <algorithm>
+
+using namespace gplot::core;
+
+ThreadPool::ThreadPool(size_t thread_count)
+{
+    // The calling thread takes part in ParallelFor, so one thread less is enough to keep every core busy
+    thread_count = std::max<size_t>(thread_count, 2) - 1;
+
+    m_workers.reserve(thread_count);
+    for (size_t i = 0; i < thread_count; i++)
+    {
+        m_workers.emplace_back([this]() { WorkerLoop(); });
+    }
+}
+
+ThreadPool::~ThreadPool() noexcept
+{
+    {
+        std::lock_guard lock(m_mutex);
+        m_stop = true;
+    }
+
+    m_condition.notify_all();
+    for (auto& worker : m_workers)
+    {
+        worker.join();
+    }
+}
+
+void ThreadPool::ParallelFor(size_t count, size_t grain, const std::function<void(size_t begin, size_t end)>& task)
+{
+    if (count == 0)
+    {
+        return;
+    }
+
+    grain = std::max<size_t>(grain, 1);
+    const size_t chunks = std::min((count + grain - 1) / grain, (m_workers.size() + 1) * 4);
+    if (chunks <= 1)
+    {
+        task(0, count);
+        return;
+    }
+
+    struct State
+    {
+        std::atomic<size_t> next { 0 };
+        std::atomic<size_t> done { 0 };
+        std::mutex mutex;
+        std::condition_variable condition;
+    };
+
+    auto state = std::make_shared<State>();
+    const size_t chunk_size = (count + chunks - 1) / chunks;
+
+    // Helpers that start after every chunk was claimed exit without touching `task`
+    const auto run = [state, chunks, chunk_size, count, &task]()
+    {
+        for (size_t chunk = state->next++; chunk < chunks; chunk = state->next++)
+        {
+            task(chunk * chunk_size, std::min(count, (chunk + 1) * chunk_size));
+
+            if (++state->done == chunks)
+            {
+                std::lock_guard lock(state->mutex);
+                state->condition.notify_all();
+            }
+        }
+    };
+
+    const size_t helpers = std::min(chunks - 1, m_workers.size());
+    for (size_t i = 0; i < helpers; i++)
+    {
+        Enqueue(run);
+    }
+
+    run();
+
+    std::unique_lock lock(state->mutex);
+    state->condition.wait(lock, [&]() { return state->done == chunks; });
+}
+
+size_t ThreadPool::GetThreadCount() const noexcept
+{
+    return m_workers.size();
+}
+
+ThreadPool& ThreadPool::GetDefault()
+{
+    static ThreadPool pool;
+    return pool;
+}
+
+void ThreadPool::Enqueue(std::function<void()> task)
+{
+    {
+        std::lock_guard lock(m_mutex);
+        m_tasks.push(std::move(task));
+    }
+
+    m_condition.notify_one();
+}
+
+void ThreadPool::WorkerLoop()
+{
+    while (true)
+    {
+        std::function<void()> task;
+        {
+            std::unique_lock lock(m_mutex);
+            m_condition.wait(lock, [this]() { return m_stop || !m_tasks.empty(); });
+
+            if (m_stop && m_tasks.empty())
+            {
+                return;
+            }
+
+            task = std::move(m_tasks.front());
+            m_tasks.pop();
+        }
+
+        task();
+    }
+}
@@ -0,0 +1,39 @@
+#include <Graphics/BufferTexture.hpp>
+#include <Graphics/StateCache.hpp>
+
+using namespace gplot::graphics;
+
+BufferTexture::BufferTexture() noexcept
+{
+    glGenTextures(1, &m_texture);
+}
+
+BufferTexture::~BufferTexture() noexcept
+{
+    StateCache::Get().ForgetTexture(m_texture);
+    glDeleteTextures(1, &m_texture);
+}
+
+void BufferTexture::Attach(GLuint buffer, GLenum format) const
+{
+    StateCache::Get().BindTexture(0, GL_TEXTURE_BUFFER, m_texture);
+    glTexBuffer(GL_TEXTURE_BUFFER, format, buffer);
+}
+
+void BufferTexture::Bind(int unit) const
+{
+    StateCache::Get().BindTexture(static_cast<GLuint>(unit), GL_TEXTURE_BUFFER, m_texture);
+}
+
+GLint BufferTexture::GetMaxTexels()
+{
+    GLint texels = 0;
+    glGetIntegerv(GL_MAX_TEXTURE_BUFFER_SIZE, &texels);
+
+    return texels;
+}
+
+GLuint BufferTexture::GetTextureId() const noexcept
+{
+    return m_texture;
+}
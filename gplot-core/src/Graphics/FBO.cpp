@@ -1,4 +1,5 @@
 #include <Graphics/FBO.hpp>
+#include <Graphics/StateCache.hpp>
 
 using namespace gplot::graphics;
 
@@ -9,24 +10,23 @@ FBO::FBO() noexcept
 
 FBO::~FBO() noexcept
 {
+    StateCache::Get().ForgetFramebuffer(m_id);
     glDeleteFramebuffers(1, &m_id);
 }
 
 void FBO::Bind() const
 {
-    glBindFramebuffer(GL_FRAMEBUFFER, m_id);
+    StateCache::Get().BindFramebuffer(GL_FRAMEBUFFER, m_id);
 }
 
 void FBO::SetTexture(GLuint texture)
 {
     m_color_texture = texture;
-    glBindFramebuffer(GL_FRAMEBUFFER, m_id);
+    StateCache::Get().BindFramebuffer(GL_FRAMEBUFFER, m_id);
     glFramebufferTexture2D(GL_DRAW_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, texture, 0);
 
     constexpr GLenum attachments[1] = { GL_COLOR_ATTACHMENT0 };
     glDrawBuffers(1, attachments);
-
-    glBindFramebuffer(GL_FRAMEBUFFER, 0);
 }
 
 GLuint FBO::GetColorTexture() const noexcept
@@ -34,9 +34,14 @@ GLuint FBO::GetColorTexture() const noexcept
     return m_color_texture;
 }
 
+GLuint FBO::GetId() const noexcept
+{
+    return m_id;
+}
+
 void FBO::Reset() noexcept
 {
-    glBindFramebuffer(GL_FRAMEBUFFER, s_default_fbo_id);
+    StateCache::Get().BindFramebuffer(GL_FRAMEBUFFER, s_default_fbo_id);
 }
 
 void FBO::SetDefaultFramebuffer(GLuint fbo)
@@ -0,0 +1,159 @@
+#include <Graphics/HeadlessContext.hpp>
+
+#include <glad/glad.h>
+
+#include <stdexcept>
+#include <string_view>
+
+#ifdef GPLOT_HEADLESS_EGL
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
+#endif
+
+using namespace gplot::graphics;
+
+#ifdef GPLOT_HEADLESS_EGL
+
+namespace
+{
+    bool HasExtension(EGLDisplay display, std::string_view name)
+    {
+        const char* extensions = eglQueryString(display, EGL_EXTENSIONS);
+        if (!extensions)
+        {
+            return false;
+        }
+
+        for (std::string_view list(extensions); !list.empty();)
+        {
+            const auto end = list.find(' ');
+            if (list.substr(0, end) == name)
+            {
+                return true;
+            }
+
+            list = end == std::string_view::npos ? std::string_view() : list.substr(end + 1);
+        }
+
+        return false;
+    }
+
+    EGLDisplay OpenDisplay()
+    {
+        // Surfaceless needs neither a window system nor a GPU, the default display is the fallback for other drivers
+        if (HasExtension(EGL_NO_DISPLAY, "EGL_MESA_platform_surfaceless"))
+        {
+            const auto get_platform_display = reinterpret_cast<PFNEGLGETPLATFORMDISPLAYEXTPROC>(eglGetProcAddress("eglGetPlatformDisplayEXT"));
+            if (get_platform_display)
+            {
+                return get_platform_display(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, nullptr);
+            }
+        }
+
+        return eglGetDisplay(EGL_DEFAULT_DISPLAY);
+    }
+}
+
+HeadlessContext::HeadlessContext()
+{
+    EGLDisplay display = OpenDisplay();
+    if (display == EGL_NO_DISPLAY || !eglInitialize(display, nullptr, nullptr))
+    {
+        throw std::runtime_error("Failed to initialize an EGL display");
+    }
+    m_display = display;
+
+    if (!eglBindAPI(EGL_OPENGL_API))
+    {
+        eglTerminate(display);
+        throw std::runtime_error("EGL display does not support desktop OpenGL");
+    }
+
+    // The context is made current without any surface
+    if (!HasExtension(display, "EGL_KHR_surfaceless_context"))
+    {
+        eglTerminate(display);
+        throw std::runtime_error("EGL display does not support surfaceless contexts (EGL_KHR_surfaceless_context)");
+    }
+
+    EGLConfig config = EGL_NO_CONFIG_KHR;
+    if (!HasExtension(display, "EGL_KHR_no_config_context"))
+    {
+        constexpr EGLint config_attributes[] = { EGL_RENDERABLE_TYPE, EGL_OPENGL_BIT, EGL_NONE };
+
+        EGLint count = 0;
+        eglChooseConfig(display, config_attributes, &config, 1, &count);
+    }
+
+    constexpr EGLint context_attributes[] =
+    {
+        EGL_CONTEXT_MAJOR_VERSION, 3,
+        EGL_CONTEXT_MINOR_VERSION, 3,
+        EGL_CONTEXT_OPENGL_PROFILE_MASK, EGL_CONTEXT_OPENGL_CORE_PROFILE_BIT,
+        EGL_NONE
+    };
+
+    EGLContext context = eglCreateContext(display, config, EGL_NO_CONTEXT, context_attributes);
+    if (context == EGL_NO_CONTEXT)
+    {
+        eglTerminate(display);
+        throw std::runtime_error("Failed to create an OpenGL 3.3 core EGL context");
+    }
+    m_context = context;
+
+    // The destructor does not run for a throwing constructor, so each failure below releases the context itself
+    if (!eglMakeCurrent(display, EGL_NO_SURFACE, EGL_NO_SURFACE, context))
+    {
+        eglDestroyContext(display, context);
+        eglTerminate(display);
+        throw std::runtime_error("Failed to make the EGL context current");
+    }
+
+    if (!gladLoadGLLoader(reinterpret_cast<GLADloadproc>(eglGetProcAddress)))
+    {
+        eglMakeCurrent(display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+        eglDestroyContext(display, context);
+        eglTerminate(display);
+        throw std::runtime_error("Failed to load OpenGL functions");
+    }
+}
+
+HeadlessContext::~HeadlessContext() noexcept
+{
+    eglMakeCurrent(m_display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+    eglDestroyContext(m_display, m_context);
+    eglTerminate(m_display);
+}
+
+void HeadlessContext::MakeCurrent() const
+{
+    if (!eglMakeCurrent(m_display, EGL_NO_SURFACE, EGL_NO_SURFACE, m_context))
+    {
+        throw std::runtime_error("Failed to make the EGL context current");
+    }
+}
+
+bool HeadlessContext::IsSupported() noexcept
+{
+    return true;
+}
+
+#else
+
+HeadlessContext::HeadlessContext()
+{
+    throw std::runtime_error("gplot-core was built without EGL, headless contexts are unavailable");
+}
+
+HeadlessContext::~HeadlessContext() noexcept = default;
+
+void HeadlessContext::MakeCurrent() const
+{
+}
+
+bool HeadlessContext::IsSupported() noexcept
+{
+    return false;
+}
+
+#endif
@@ -0,0 +1,60 @@
+#include <Graphics/IndirectBuffer.hpp>
+#include <Graphics/StateCache.hpp>
+
+#include <algorithm>
+
+using namespace gplot::graphics;
+
+IndirectBuffer::IndirectBuffer() noexcept
+{
+    glGenBuffers(1, &m_id);
+}
+
+IndirectBuffer::~IndirectBuffer() noexcept
+{
+    StateCache::Get().ForgetBuffer(m_id);
+    glDeleteBuffers(1, &m_id);
+}
+
+void IndirectBuffer::Update(std::span<const DrawArraysCommand> commands)
+{
+    Bind();
+
+    m_count = commands.size();
+    if (m_count > m_capacity)
+    {
+        m_capacity = std::max(m_count, m_capacity * 2);
+        glBufferData(GL_DRAW_INDIRECT_BUFFER, static_cast<GLsizeiptr>(sizeof(DrawArraysCommand) * m_capacity), nullptr, GL_DYNAMIC_DRAW);
+    }
+
+    if (m_count > 0)
+    {
+        glBufferSubData(GL_DRAW_INDIRECT_BUFFER, 0, static_cast<GLsizeiptr>(commands.size_bytes()), commands.data());
+    }
+}
+
+void IndirectBuffer::SetInstanceCount(size_t index, GLuint instance_count) const
+{
+    if (index >= m_count)
+    {
+        return;
+    }
+
+    Bind();
+    glBufferSubData(GL_DRAW_INDIRECT_BUFFER, static_cast<GLintptr>(sizeof(DrawArraysCommand) * index + offsetof(DrawArraysCommand, instance_count)), sizeof(GLuint), &instance_count);
+}
+
+void IndirectBuffer::Bind() const
+{
+    StateCache::Get().BindBuffer(GL_DRAW_INDIRECT_BUFFER, m_id);
+}
+
+size_t IndirectBuffer::GetCommandCount() const noexcept
+{
+    return m_count;
+}
+
+bool IndirectBuffer::IsSupported()
+{
+    return GLAD_GL_VERSION_4_3 != 0;
+}
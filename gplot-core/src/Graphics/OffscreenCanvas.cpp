@@ -0,0 +1,46 @@
+#include <Graphics/OffscreenCanvas.hpp>
+
+#include <Core/Image.hpp>
+
+using namespace gplot::graphics;
+
+OffscreenCanvas::OffscreenCanvas(Texture::texsize size)
+    : m_texture(size)
+{
+    m_framebuffer.SetTexture(m_texture.GetTextureId());
+}
+
+void OffscreenCanvas::Bind() const
+{
+    m_framebuffer.Bind();
+    glViewport(0, 0, m_texture.GetSize().x, m_texture.GetSize().y);
+}
+
+void OffscreenCanvas::ReadPixels(std::vector<std::uint8_t>& pixels) const
+{
+    const auto size = m_texture.GetSize();
+    const size_t row_size = static_cast<size_t>(size.x) * 4;
+
+    pixels.resize(row_size * size.y);
+
+    m_framebuffer.Bind();
+    glPixelStorei(GL_PACK_ALIGNMENT, 1);
+    glReadPixels(0, 0, size.x, size.y, GL_RGBA, GL_UNSIGNED_BYTE, pixels.data());
+
+    gplot::core::FlipRows(pixels.data(), row_size, size.y);
+}
+
+Texture::texsize OffscreenCanvas::GetSize() const
+{
+    return m_texture.GetSize();
+}
+
+const FBO& OffscreenCanvas::GetFramebuffer() const noexcept
+{
+    return m_framebuffer;
+}
+
+const Texture& OffscreenCanvas::GetTexture() const noexcept
+{
+    return m_texture;
+}
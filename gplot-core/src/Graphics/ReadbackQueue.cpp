@@ -0,0 +1,154 @@
+#include <Graphics/ReadbackQueue.hpp>
+
+#include <Core/Image.hpp>
+#include <Graphics/StateCache.hpp>
+
+#include <cstring>
+#include <algorithm>
+
+using namespace gplot::graphics;
+
+namespace
+{
+    constexpr GLuint64 FENCE_TIMEOUT = 1'000'000'000; // 1s
+}
+
+ReadbackQueue::ReadbackQueue(Texture::texsize size, size_t depth, gplot::core::ThreadPool& pool)
+    : m_size(size)
+    , m_pool(pool)
+    , m_slots(std::max<size_t>(depth, 1))
+{
+    const auto buffer_size = static_cast<GLsizeiptr>(m_size.x) * m_size.y * 4;
+    for (auto& slot : m_slots)
+    {
+        glGenBuffers(1, &slot.buffer);
+        StateCache::Get().BindBuffer(GL_PIXEL_PACK_BUFFER, slot.buffer);
+        glBufferData(GL_PIXEL_PACK_BUFFER, buffer_size, nullptr, GL_STREAM_READ);
+    }
+    StateCache::Get().BindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+}
+
+ReadbackQueue::~ReadbackQueue() noexcept
+{
+    while (m_pending > 0)
+    {
+        Collect(GetOldest(), true);
+    }
+
+    for (auto& callback : m_callbacks)
+    {
+        callback.wait();
+    }
+
+    for (auto& slot : m_slots)
+    {
+        StateCache::Get().ForgetBuffer(slot.buffer);
+        glDeleteBuffers(1, &slot.buffer);
+    }
+}
+
+void ReadbackQueue::Capture(const FBO& framebuffer, Callback on_ready)
+{
+    if (m_pending == m_slots.size())
+    {
+        Collect(GetOldest(), true);
+    }
+
+    auto& slot = m_slots[m_head];
+
+    StateCache::Get().BindFramebuffer(GL_READ_FRAMEBUFFER, framebuffer.GetId());
+    StateCache::Get().BindBuffer(GL_PIXEL_PACK_BUFFER, slot.buffer);
+    glPixelStorei(GL_PACK_ALIGNMENT, 1);
+    glReadPixels(0, 0, m_size.x, m_size.y, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+    StateCache::Get().BindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+    // Headless callers never swap, an unflushed fence polled with a zero timeout may never signal
+    slot.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    glFlush();
+    slot.callback = std::move(on_ready);
+    slot.frame = m_frame++;
+
+    m_head = (m_head + 1) % m_slots.size();
+    m_pending++;
+}
+
+void ReadbackQueue::Poll()
+{
+    while (m_pending > 0)
+    {
+        auto& slot = GetOldest();
+        if (glClientWaitSync(slot.fence, 0, 0) == GL_TIMEOUT_EXPIRED)
+        {
+            break;
+        }
+
+        Collect(slot, false);
+    }
+
+    std::erase_if(m_callbacks, [](std::future<void>& callback)
+    {
+        if (callback.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+        {
+            return false;
+        }
+
+        callback.get();
+        return true;
+    });
+}
+
+void ReadbackQueue::Flush()
+{
+    while (m_pending > 0)
+    {
+        Collect(GetOldest(), true);
+    }
+
+    for (auto& callback : m_callbacks)
+    {
+        callback.get();
+    }
+    m_callbacks.clear();
+}
+
+size_t ReadbackQueue::GetPendingCount() const noexcept
+{
+    return m_pending;
+}
+
+void ReadbackQueue::Collect(Slot& slot, bool wait)
+{
+    if (wait)
+    {
+        while (glClientWaitSync(slot.fence, GL_SYNC_FLUSH_COMMANDS_BIT, FENCE_TIMEOUT) == GL_TIMEOUT_EXPIRED)
+        {
+        }
+    }
+
+    glDeleteSync(slot.fence);
+    slot.fence = nullptr;
+    m_pending--;
+
+    // Mapping has to happen on the GL thread, flipping and the callback do not
+    std::vector<std::uint8_t> pixels(static_cast<size_t>(m_size.x) * m_size.y * 4);
+
+    StateCache::Get().BindBuffer(GL_PIXEL_PACK_BUFFER, slot.buffer);
+    if (const auto* mapped = glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, static_cast<GLsizeiptr>(pixels.size()), GL_MAP_READ_BIT))
+    {
+        std::memcpy(pixels.data(), mapped, pixels.size());
+        glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+    }
+    StateCache::Get().BindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+    m_callbacks.push_back(m_pool.Submit([pixels = std::move(pixels), callback = std::move(slot.callback), size = m_size, frame = slot.frame]() mutable
+    {
+        gplot::core::FlipRows(pixels.data(), static_cast<size_t>(size.x) * 4, size.y);
+        callback(std::move(pixels), size, frame);
+    }));
+    slot.callback = nullptr;
+}
+
+ReadbackQueue::Slot& ReadbackQueue::GetOldest()
+{
+    return m_slots[(m_head + m_slots.size() - m_pending) % m_slots.size()];
+}
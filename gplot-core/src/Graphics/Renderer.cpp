@@ -0,0 +1,365 @@
+#include <Graphics/Renderer.hpp>
+#include <Graphics/StateCache.hpp>
+
+#include <tuple>
+#include <cstring>
+#include <cstdint>
+#include <iostream>
+#include <algorithm>
+
+using namespace gplot::graphics;
+
+namespace
+{
+    constexpr size_t MIN_UNIFORM_CAPACITY = 4096;
+
+    GLenum ToGLPrimitive(Primitive primitive)
+    {
+        switch (primitive)
+        {
+            case Primitive::eLines:               return GL_LINES;
+            case Primitive::eLinesStrip:          return GL_LINE_STRIP;
+            case Primitive::eLinesStripAdjacent:  return GL_LINE_STRIP_ADJACENCY;
+            case Primitive::eTriangleStrip:       return GL_TRIANGLE_STRIP;
+        }
+
+        return GL_LINES;
+    }
+
+    void ApplyBlend(BlendMode blend)
+    {
+        switch (blend)
+        {
+            case BlendMode::eInherit:
+                break;
+            case BlendMode::eOpaque:
+                glDisable(GL_BLEND);
+                break;
+            case BlendMode::eAlpha:
+                glEnable(GL_BLEND);
+                glBlendFuncSeparate(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA, GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
+                break;
+        }
+    }
+}
+
+Renderer::Renderer()
+    : m_uniform_alignment(UniformBuffer::GetOffsetAlignment())
+{
+    m_current_blocks.fill(-1);
+}
+
+void Renderer::PrepareFrame()
+{
+    m_commands.clear();
+    m_offsets.clear();
+    m_sizes.clear();
+    m_targets.clear();
+    m_program_ranks.clear();
+    m_buffer_ranks.clear();
+    m_uniform_data.clear();
+    m_uniform_blocks.clear();
+
+    m_current_target = -1;
+    m_current_state = { };
+    m_current_blocks.fill(-1);
+}
+
+void Renderer::RenderCurrent()
+{
+    m_statistics = { };
+    m_statistics.commands = m_commands.size();
+
+    if (m_commands.empty())
+    {
+        return;
+    }
+
+    UploadUniformBlocks();
+
+    const auto key = [this](size_t index)
+    {
+        const auto& command = m_commands[index];
+        return std::make_tuple(command.target,
+                               command.state.layer,
+                               command.program_rank,
+                               command.state.blend,
+                               command.buffer_rank,
+                               command.uniform_blocks);
+    };
+
+    // Stable, so commands sharing a key keep their recording order
+    m_order.resize(m_commands.size());
+    for (size_t i = 0; i < m_order.size(); i++)
+    {
+        m_order[i] = i;
+    }
+    std::stable_sort(m_order.begin(), m_order.end(), [&](size_t a, size_t b) { return key(a) < key(b); });
+
+    const Command* previous = nullptr;
+    for (size_t i = 0; i < m_order.size();)
+    {
+        const auto& command = m_commands[m_order[i]];
+        ApplyState(command, previous);
+
+        size_t next = i + 1;
+        if (command.type == CommandType::eInstancedRanges)
+        {
+            for (size_t r = command.first_range; r < command.first_range + command.range_count; r++)
+            {
+                glDrawArraysInstanced(ToGLPrimitive(command.primitive), m_offsets[r], command.instance_vertices, m_sizes[r]);
+                m_statistics.draw_calls++;
+            }
+        }
+        else if (command.type == CommandType::eMultiIndirect)
+        {
+            command.indirect->Bind();
+            glMultiDrawArraysIndirect(ToGLPrimitive(command.primitive), nullptr, static_cast<GLsizei>(command.indirect->GetCommandCount()), 0);
+            m_statistics.draw_calls++;
+        }
+        else
+        {
+            m_merged_offsets.assign(m_offsets.begin() + command.first_range, m_offsets.begin() + command.first_range + command.range_count);
+            m_merged_sizes.assign(m_sizes.begin() + command.first_range, m_sizes.begin() + command.first_range + command.range_count);
+
+            for (; next < m_order.size() && CanMerge(command, m_commands[m_order[next]]); next++)
+            {
+                const auto& merged = m_commands[m_order[next]];
+                m_merged_offsets.insert(m_merged_offsets.end(), m_offsets.begin() + merged.first_range, m_offsets.begin() + merged.first_range + merged.range_count);
+                m_merged_sizes.insert(m_merged_sizes.end(), m_sizes.begin() + merged.first_range, m_sizes.begin() + merged.first_range + merged.range_count);
+                m_statistics.merged++;
+            }
+
+            glMultiDrawArrays(ToGLPrimitive(command.primitive), m_merged_offsets.data(), m_merged_sizes.data(), static_cast<GLsizei>(m_merged_offsets.size()));
+            m_statistics.draw_calls++;
+        }
+
+        previous = &command;
+        i = next;
+    }
+}
+
+void Renderer::ResizeWindowCanvas(int width, int height)
+{
+    m_window_size = { width, height };
+}
+
+void Renderer::SetTarget(std::optional<RenderTarget> target)
+{
+    if (!target)
+    {
+        m_current_target = -1;
+        return;
+    }
+
+    const auto it = std::find(m_targets.begin(), m_targets.end(), *target);
+    if (it != m_targets.end())
+    {
+        m_current_target = static_cast<int>(it - m_targets.begin());
+        return;
+    }
+
+    m_current_target = static_cast<int>(m_targets.size());
+    m_targets.push_back(*target);
+}
+
+void Renderer::SetState(const RenderState& state)
+{
+    m_current_state = state;
+}
+
+void Renderer::SetUniformBlock(GLuint binding, const void* data, size_t size)
+{
+    if (binding >= UNIFORM_BLOCK_BINDINGS)
+    {
+        std::cerr << __FILE__ << ":" << __LINE__ << " Uniform block binding " << binding << " is not tracked by the renderer" << std::endl;
+        return;
+    }
+
+    const size_t offset = (m_uniform_data.size() + m_uniform_alignment - 1) / m_uniform_alignment * m_uniform_alignment;
+
+    m_uniform_data.resize(offset + size);
+    std::memcpy(m_uniform_data.data() + offset, data, size);
+
+    m_current_blocks[binding] = static_cast<int>(m_uniform_blocks.size());
+    m_uniform_blocks.push_back({ binding, offset, size });
+}
+
+void Renderer::RenderMultiBuffer(Primitive primitive, const VertexBuffer& buffer, std::span<const GLint> offsets, std::span<const GLsizei> sizes)
+{
+    Command command;
+    command.buffer = &buffer;
+    command.primitive = primitive;
+
+    Record(command, offsets, sizes);
+}
+
+void Renderer::RenderInstancedRanges(Primitive primitive, const VertexBuffer& buffer, GLsizei instance_vertices, std::span<const GLint> offsets, std::span<const GLsizei> instance_counts)
+{
+    Command command;
+    command.type = CommandType::eInstancedRanges;
+    command.buffer = &buffer;
+    command.primitive = primitive;
+    command.instance_vertices = instance_vertices;
+
+    Record(command, offsets, instance_counts);
+}
+
+void Renderer::RenderMultiIndirect(Primitive primitive, const VertexBuffer& buffer, const IndirectBuffer& commands)
+{
+    if (commands.GetCommandCount() == 0)
+    {
+        return;
+    }
+
+    Command command;
+    command.type = CommandType::eMultiIndirect;
+    command.buffer = &buffer;
+    command.primitive = primitive;
+    command.indirect = &commands;
+
+    Record(command, { }, { });
+}
+
+const Renderer::Statistics& Renderer::GetStatistics() const noexcept
+{
+    return m_statistics;
+}
+
+void Renderer::Record(Command command, std::span<const GLint> offsets, std::span<const GLsizei> sizes)
+{
+    if (offsets.empty() && command.type != CommandType::eMultiIndirect)
+    {
+        return;
+    }
+
+    if (m_current_state.shader == nullptr)
+    {
+        std::cerr << __FILE__ << ":" << __LINE__ << " Draw recorded without a shader, skipping" << std::endl;
+        return;
+    }
+
+    command.target = m_current_target;
+    command.state = m_current_state;
+    command.uniform_blocks = m_current_blocks;
+    command.program_rank = GetRank(m_program_ranks, command.state.shader);
+    command.buffer_rank = GetRank(m_buffer_ranks, command.buffer);
+    command.first_range = m_offsets.size();
+    command.range_count = offsets.size();
+
+    m_offsets.insert(m_offsets.end(), offsets.begin(), offsets.end());
+    m_sizes.insert(m_sizes.end(), sizes.begin(), sizes.end());
+
+    m_commands.push_back(command);
+}
+
+bool Renderer::CanMerge(const Command& first, const Command& second)
+{
+    return first.type == CommandType::eMultiDraw && second.type == CommandType::eMultiDraw
+        && first.target == second.target
+        && first.state.shader == second.state.shader
+        && first.state.blend == second.state.blend
+        && first.state.texel_buffers == second.state.texel_buffers
+        && first.state.vertex_pulling == second.state.vertex_pulling
+        && first.buffer == second.buffer
+        && first.primitive == second.primitive
+        && first.state.textures == second.state.textures
+        && first.uniform_blocks == second.uniform_blocks;
+}
+
+std::uint32_t Renderer::GetRank(std::unordered_map<const void*, std::uint32_t>& ranks, const void* object)
+{
+    return ranks.try_emplace(object, static_cast<std::uint32_t>(ranks.size())).first->second;
+}
+
+void Renderer::ApplyState(const Command& command, const Command* previous)
+{
+    auto& cache = StateCache::Get();
+
+    if (command.target >= 0 && (previous == nullptr || previous->target != command.target))
+    {
+        const auto& target = m_targets[command.target];
+        cache.BindFramebuffer(GL_FRAMEBUFFER, target.framebuffer);
+
+        if (target.viewport.z > 0 && target.viewport.w > 0)
+        {
+            glViewport(target.viewport.x, target.viewport.y, target.viewport.z, target.viewport.w);
+        }
+        else
+        {
+            glViewport(0, 0, m_window_size.x, m_window_size.y);
+        }
+    }
+
+    if (previous == nullptr || previous->state.blend != command.state.blend)
+    {
+        ApplyBlend(command.state.blend);
+    }
+
+    command.state.shader->Use();
+    if (command.state.vertex_pulling)
+    {
+        command.buffer->BindInstanceAttributes();
+    }
+    else
+    {
+        command.buffer->Bind();
+    }
+
+    for (const int index : command.uniform_blocks)
+    {
+        if (index >= 0)
+        {
+            const auto& block = m_uniform_blocks[index];
+            m_uniform_buffer->BindRange(block.binding, block.offset, block.size);
+        }
+    }
+
+    for (const auto& binding : command.state.textures)
+    {
+        if (binding.texture != 0)
+        {
+            cache.BindTexture(binding.unit, binding.target, binding.texture);
+        }
+    }
+
+    // Attaching re-specifies the texture storage, skip it while consecutive commands read the same buffers.
+    // Attach goes through unit 0, so every texture is attached before any of them is bound to its unit.
+    if (previous == nullptr || previous->state.texel_buffers != command.state.texel_buffers)
+    {
+        for (const auto& binding : command.state.texel_buffers)
+        {
+            if (binding.texture != nullptr)
+            {
+                binding.texture->Attach(binding.buffer, binding.format);
+            }
+        }
+
+        for (const auto& binding : command.state.texel_buffers)
+        {
+            if (binding.texture != nullptr)
+            {
+                binding.texture->Bind(static_cast<int>(binding.unit));
+            }
+        }
+    }
+}
+
+void Renderer::UploadUniformBlocks()
+{
+    if (m_uniform_data.empty())
+    {
+        return;
+    }
+
+    if (!m_uniform_buffer || m_uniform_buffer->GetSize() < m_uniform_data.size())
+    {
+        m_uniform_buffer = std::make_unique<UniformBuffer>(std::max(MIN_UNIFORM_CAPACITY, m_uniform_data.size() * 2));
+    }
+    else
+    {
+        m_uniform_buffer->Orphan();
+    }
+
+    m_uniform_buffer->Update(0, m_uniform_data.size(), m_uniform_data.data());
+}
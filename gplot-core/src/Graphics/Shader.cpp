@@ -1,14 +1,98 @@
 #include <iostream>
 #include <Graphics/Shader.hpp>
+#include <Graphics/StateCache.hpp>
+#include <Core/DriveIO.hpp>
 
 #include <glad/glad.h>
 #include <glm/gtc/type_ptr.hpp>
 
+#include <cstring>
+#include <algorithm>
+#include <filesystem>
+
 using namespace gplot::graphics;
 
 namespace
 {
-    constexpr const char* CACHE_DIR = ".cache/shader";
+    constexpr std::uint32_t CACHE_MAGIC = 0x42535047; // "GPSB"
+
+    constexpr std::uint64_t FNV_OFFSET = 0xCBF29CE484222325ULL;
+    constexpr std::uint64_t FNV_PRIME = 0x100000001B3ULL;
+
+    struct BinaryHeader
+    {
+        std::uint32_t magic;
+        std::uint32_t format;
+    };
+
+    std::uint64_t HashFNV1a(std::string_view data, std::uint64_t hash = FNV_OFFSET)
+    {
+        for (const char c : data)
+        {
+            hash = (hash ^ static_cast<std::uint8_t>(c)) * FNV_PRIME;
+        }
+
+        // Separator, so moving text between the hashed strings changes the result
+        return (hash ^ 0xFF) * FNV_PRIME;
+    }
+
+    std::string_view GetString(GLenum name)
+    {
+        const auto* value = reinterpret_cast<const char*>(glGetString(name));
+        return value ? value : "";
+    }
+
+    void SetUniform(GLint location, int value)
+    {
+        glUniform1i(location, value);
+    }
+
+    void SetUniform(GLint location, float value)
+    {
+        glUniform1f(location, value);
+    }
+
+    void SetUniform(GLint location, const glm::vec2& value)
+    {
+        glUniform2fv(location, 1, glm::value_ptr(value));
+    }
+
+    void SetUniform(GLint location, const glm::vec3& value)
+    {
+        glUniform3fv(location, 1, glm::value_ptr(value));
+    }
+
+    void SetUniform(GLint location, const glm::vec4& value)
+    {
+        glUniform4fv(location, 1, glm::value_ptr(value));
+    }
+
+    void SetUniform(GLint location, const glm::mat2& value)
+    {
+        glUniformMatrix2fv(location, 1, GL_FALSE, glm::value_ptr(value));
+    }
+
+    void SetUniform(GLint location, const glm::mat3& value)
+    {
+        glUniformMatrix3fv(location, 1, GL_FALSE, glm::value_ptr(value));
+    }
+
+    void SetUniform(GLint location, const glm::mat4& value)
+    {
+        glUniformMatrix4fv(location, 1, GL_FALSE, glm::value_ptr(value));
+    }
+
+    bool IsBinaryCacheSupported()
+    {
+        if (!GLAD_GL_VERSION_4_1)
+        {
+            return false;
+        }
+
+        GLint formats = 0;
+        glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formats);
+        return formats > 0;
+    }
 
     bool CheckForErrors(GLuint id, std::uint64_t type)
     {
@@ -37,10 +121,63 @@ namespace
     }
 }
 
+std::string Shader::s_cache_dir;
+
 Shader::Shader(std::string_view name, const char* vertex_src, const char* fragment_src, const char* geometry_src)
+{
+    const auto cache_path = GetBinaryCachePath(name, vertex_src, fragment_src, geometry_src);
+    if (cache_path.empty() || !LoadProgramBinary(cache_path))
+    {
+        if (!CompileProgram(vertex_src, fragment_src, geometry_src, !cache_path.empty()))
+        {
+            throw std::runtime_error(std::string("Failed to create shader ") + name.data());
+        }
+
+        if (!cache_path.empty())
+        {
+            StoreProgramBinary(cache_path);
+        }
+    }
+
+    CollectUniforms();
+}
+
+Shader::~Shader()
+{
+    StateCache::Get().ForgetProgram(m_id);
+    glDeleteProgram(m_id);
+}
+
+void Shader::SetBinaryCacheDirectory(std::string directory)
+{
+    s_cache_dir = std::move(directory);
+}
+
+std::string Shader::GetBinaryCachePath(std::string_view name, const char* vertex_src, const char* fragment_src, const char* geometry_src)
+{
+    if (s_cache_dir.empty() || !IsBinaryCacheSupported())
+    {
+        return { };
+    }
+
+    // Binaries are only valid for the driver that produced them
+    std::uint64_t hash = HashFNV1a(vertex_src);
+    hash = HashFNV1a(fragment_src, hash);
+    hash = HashFNV1a(geometry_src ? geometry_src : "", hash);
+    hash = HashFNV1a(GetString(GL_VENDOR), hash);
+    hash = HashFNV1a(GetString(GL_RENDERER), hash);
+    hash = HashFNV1a(GetString(GL_VERSION), hash);
+
+    char hex[17];
+    std::snprintf(hex, sizeof(hex), "%016llx", static_cast<unsigned long long>(hash));
+
+    return s_cache_dir + "/" + std::string(name) + "-" + hex + ".bin";
+}
+
+bool Shader::CompileProgram(const char* vertex_src, const char* fragment_src, const char* geometry_src, bool retrievable)
 {
     bool success = true;
-    GLuint vertex_id, fragment_id, geometry_id;
+    GLuint vertex_id, fragment_id, geometry_id = 0;
 
     vertex_id = glCreateShader(GL_VERTEX_SHADER);
     fragment_id = glCreateShader(GL_FRAGMENT_SHADER);
@@ -69,6 +206,12 @@ Shader::Shader(std::string_view name, const char* vertex_src, const char* fragme
 
         glAttachShader(m_id, geometry_id);
     }
+
+    if (retrievable)
+    {
+        glProgramParameteri(m_id, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+    }
+
     glLinkProgram(m_id);
     success &= CheckForErrors(m_id, GL_LINK_STATUS);
 
@@ -76,74 +219,157 @@ Shader::Shader(std::string_view name, const char* vertex_src, const char* fragme
     glDeleteShader(fragment_id);
     if(geometry_src)
     {
-        glDeleteShader(fragment_id);
+        glDeleteShader(geometry_id);
+    }
+
+    return success;
+}
+
+bool Shader::LoadProgramBinary(const std::string& path)
+{
+    std::error_code error;
+    if (!std::filesystem::exists(path, error))
+    {
+        return false;
+    }
+
+    gplot::core::DriveIO disk_io;
+    auto data = disk_io.Read(path);
+
+    // DriveIO terminates the data with '\0'
+    if (data.size() <= sizeof(BinaryHeader) + 1)
+    {
+        return false;
+    }
+
+    BinaryHeader header { };
+    std::memcpy(&header, data.data(), sizeof(header));
+    if (header.magic != CACHE_MAGIC)
+    {
+        return false;
     }
 
-    if (!success)
+    m_id = glCreateProgram();
+    glProgramBinary(m_id, header.format, data.data() + sizeof(header), static_cast<GLsizei>(data.size() - sizeof(header) - 1));
+
+    // Driver updates invalidate binaries, the caller falls back to compiling
+    GLint success = 0;
+    glGetProgramiv(m_id, GL_LINK_STATUS, &success);
+    if (success == 0)
     {
-        throw std::runtime_error(std::string("Failed to create shader ") + name.data());
+        glDeleteProgram(m_id);
+        m_id = 0;
+        return false;
     }
+
+    return true;
 }
 
-Shader::~Shader()
+void Shader::StoreProgramBinary(const std::string& path) const
 {
-    glDeleteProgram(m_id);
+    GLint length = 0;
+    glGetProgramiv(m_id, GL_PROGRAM_BINARY_LENGTH, &length);
+    if (length <= 0)
+    {
+        return;
+    }
+
+    gplot::core::DriveIO::file_data data(sizeof(BinaryHeader) + length);
+
+    BinaryHeader header { CACHE_MAGIC, 0 };
+    glGetProgramBinary(m_id, length, nullptr, &header.format, data.data() + sizeof(header));
+    std::memcpy(data.data(), &header, sizeof(header));
+
+    std::error_code error;
+    std::filesystem::create_directories(std::filesystem::path(path).parent_path(), error);
+
+    gplot::core::DriveIO disk_io;
+    disk_io.Write(path, data);
 }
 
 void Shader::Use() const
 {
-    glUseProgram(m_id);
+    StateCache::Get().UseProgram(m_id);
 }
 
 void Shader::Set(std::string_view name, UniformType data)
 {
-    if (!m_uniform_location_cache.contains(name))
+    const auto hash = HashName(name);
+    const auto location = FindUniform(hash, name);
+
+    // Remembers misses as well, so a missing uniform is only reported once
+    m_uniform_locations.emplace(hash, location);
+
+    std::visit([&](auto&& value) { SetUniform(location, value); }, data);
+}
+
+void Shader::BindUniformBlock(std::string_view name, unsigned int binding) const
+{
+    const auto index = glGetUniformBlockIndex(m_id, std::string(name).c_str());
+    if (index == GL_INVALID_INDEX)
     {
-        const auto location = glGetUniformLocation(m_id, name.data());
+        std::cerr << __FILE__ << __LINE__ << "Failed to locate uniform block: " << name << "\n";
+        return;
+    }
+
+    glUniformBlockBinding(m_id, index, binding);
+}
+
+void Shader::CollectUniforms()
+{
+    GLint count = 0;
+    GLint max_length = 0;
+    glGetProgramiv(m_id, GL_ACTIVE_UNIFORMS, &count);
+    glGetProgramiv(m_id, GL_ACTIVE_UNIFORM_MAX_LENGTH, &max_length);
+
+    std::string name(std::max(max_length, 1), '\0');
+    for (GLint i = 0; i < count; i++)
+    {
+        GLsizei length = 0;
+        GLint size = 0;
+        GLenum type = 0;
+        glGetActiveUniform(m_id, static_cast<GLuint>(i), max_length, &length, &size, &type, name.data());
+
+        // Members of uniform blocks have no location
+        const auto location = glGetUniformLocation(m_id, name.c_str());
         if (location == -1)
         {
-            std::cerr << __FILE__ << __LINE__ << "Failed to locate uniform: " << name << "\n";
+            continue;
         }
 
-        m_uniform_location_cache[name] = location;
-    }
-
-    const auto gl_location = m_uniform_location_cache[name];
-    std::visit([&](auto&& value)
-       {
-           using T = std::decay_t<decltype(value)>;
-           if constexpr (std::is_same_v<T, int>)
-           {
-               glUniform1i(gl_location, value);
-           }
-           else if constexpr (std::is_same_v<T, float>)
-           {
-               glUniform1f(gl_location, value);
-           }
-           else if constexpr (std::is_same_v<T, glm::vec2>)
-           {
-               glUniform2fv(gl_location, 1, glm::value_ptr(value));
-           }
-           else if constexpr (std::is_same_v<T, glm::vec3>)
-           {
-               glUniform3fv(gl_location, 1, glm::value_ptr(value));
-           }
-           else if constexpr (std::is_same_v<T, glm::vec4>)
-           {
-               glUniform4fv(gl_location, 1, glm::value_ptr(value));
-           }
-           else if constexpr (std::is_same_v<T, glm::mat2>)
-           {
-               glUniformMatrix2fv(gl_location, 1, GL_FALSE, glm::value_ptr(value));
-           }
-           else if constexpr (std::is_same_v<T, glm::mat3>)
-           {
-               glUniformMatrix3fv(gl_location, 1, GL_FALSE, glm::value_ptr(value));
-           }
-           else if constexpr (std::is_same_v<T, glm::mat4>)
-           {
-               glUniformMatrix4fv(gl_location, 1, GL_FALSE, glm::value_ptr(value));
-           }
-       }, data);
+        const std::string_view view(name.data(), length);
+        m_uniform_locations[HashName(view)] = location;
 
+        // Arrays are reported as "name[0]", both spellings address the first element
+        if (view.ends_with("[0]"))
+        {
+            m_uniform_locations[HashName(view.substr(0, view.size() - 3))] = location;
+        }
+    }
 }
+
+int Shader::FindUniform(std::uint64_t name_hash, std::string_view name) const
+{
+    if (const auto it = m_uniform_locations.find(name_hash); it != m_uniform_locations.end())
+    {
+        return it->second;
+    }
+
+    std::cerr << __FILE__ << __LINE__ << "Failed to locate uniform: " << name << "\n";
+    return -1;
+}
+
+template<typename T>
+void UniformHandle<T>::Set(const T& value) const
+{
+    SetUniform(m_location, value);
+}
+
+template class gplot::graphics::UniformHandle<int>;
+template class gplot::graphics::UniformHandle<float>;
+template class gplot::graphics::UniformHandle<glm::vec2>;
+template class gplot::graphics::UniformHandle<glm::vec3>;
+template class gplot::graphics::UniformHandle<glm::vec4>;
+template class gplot::graphics::UniformHandle<glm::mat2>;
+template class gplot::graphics::UniformHandle<glm::mat3>;
+template class gplot::graphics::UniformHandle<glm::mat4>;
@@ -0,0 +1,71 @@
+#include <Graphics/ShaderSources.hpp>
+#include <Core/DriveIO.hpp>
+
+#include <Shaders/EmbeddedShaders.hpp>
+
+#include <cstdlib>
+#include <iostream>
+#include <filesystem>
+
+namespace
+{
+    std::string& GetOverrideDirectory()
+    {
+        static std::string directory = []() -> std::string
+        {
+            const char* value = std::getenv("GPLOT_SHADER_DIR");
+            return value ? value : "";
+        }();
+
+        return directory;
+    }
+}
+
+std::string gplot::graphics::GetShaderSource(std::string_view name)
+{
+    if (const auto& directory = GetOverrideDirectory(); !directory.empty())
+    {
+        const auto path = (std::filesystem::path(directory) / name).string();
+
+        std::error_code error;
+        if (std::filesystem::exists(path, error))
+        {
+            gplot::core::DriveIO disk_io;
+            auto data = disk_io.Read(path);
+            if (!data.empty())
+            {
+                return { data.data() };
+            }
+        }
+    }
+
+    for (const auto& shader : embedded::SHADERS)
+    {
+        if (shader.name == name)
+        {
+            return std::string(shader.source);
+        }
+    }
+
+    std::cerr << __FILE__ << __LINE__ << "Unknown built-in shader: " << name << std::endl;
+    return { };
+}
+
+void gplot::graphics::SetShaderOverrideDirectory(std::string directory)
+{
+    GetOverrideDirectory() = std::move(directory);
+}
+
+std::string gplot::graphics::AddShaderDefine(std::string_view source, std::string_view define)
+{
+    const size_t line_end = source.starts_with("#version") ? source.find('\n') : std::string_view::npos;
+    const size_t split = line_end == std::string_view::npos ? 0 : line_end + 1;
+
+    std::string result;
+    result.reserve(source.size() + define.size() + 10);
+    result.append(source.substr(0, split));
+    result.append("#define ").append(define).append("\n");
+    result.append(source.substr(split));
+
+    return result;
+}
@@ -0,0 +1,231 @@
+#include <Graphics/StateCache.hpp>
+
+using namespace gplot::graphics;
+
+StateCache& StateCache::Get()
+{
+    thread_local StateCache cache = []()
+    {
+        StateCache result;
+        result.Invalidate();
+        return result;
+    }();
+
+    return cache;
+}
+
+void StateCache::UseProgram(GLuint program)
+{
+    if (Track(m_program, program))
+    {
+        glUseProgram(program);
+    }
+}
+
+void StateCache::BindVertexArray(GLuint vao)
+{
+    if (Track(m_vao, vao))
+    {
+        glBindVertexArray(vao);
+    }
+}
+
+void StateCache::BindBuffer(GLenum target, GLuint buffer)
+{
+    const int slot = GetBufferSlot(target);
+    if (slot < 0)
+    {
+        m_counters.issued++;
+        glBindBuffer(target, buffer);
+        return;
+    }
+
+    if (Track(m_buffers[slot], buffer))
+    {
+        glBindBuffer(target, buffer);
+    }
+}
+
+void StateCache::BindBufferRange(GLenum target, GLuint index, GLuint buffer, GLintptr offset, GLsizeiptr size)
+{
+    // Indexed binds also replace the generic binding of the target
+    if (const int slot = GetBufferSlot(target); slot >= 0)
+    {
+        m_buffers[slot] = buffer;
+    }
+
+    if (target == GL_UNIFORM_BUFFER && index < INDEXED_BINDINGS)
+    {
+        auto& binding = m_uniform_bindings[index];
+        if (binding.buffer == buffer && binding.offset == offset && binding.size == size)
+        {
+            m_counters.elided++;
+            return;
+        }
+
+        binding = { buffer, offset, size };
+    }
+
+    m_counters.issued++;
+    glBindBufferRange(target, index, buffer, offset, size);
+}
+
+void StateCache::BindFramebuffer(GLenum target, GLuint framebuffer)
+{
+    if (target == GL_FRAMEBUFFER)
+    {
+        if (m_draw_framebuffer == framebuffer && m_read_framebuffer == framebuffer)
+        {
+            m_counters.elided++;
+            return;
+        }
+
+        m_draw_framebuffer = framebuffer;
+        m_read_framebuffer = framebuffer;
+        m_counters.issued++;
+        glBindFramebuffer(target, framebuffer);
+        return;
+    }
+
+    if (Track(target == GL_READ_FRAMEBUFFER ? m_read_framebuffer : m_draw_framebuffer, framebuffer))
+    {
+        glBindFramebuffer(target, framebuffer);
+    }
+}
+
+void StateCache::BindTexture(GLuint unit, GLenum target, GLuint texture)
+{
+    const int slot = GetTextureSlot(target);
+    if (slot < 0 || unit >= TEXTURE_UNITS)
+    {
+        m_active_unit = unit;
+        m_counters.issued += 2;
+        glActiveTexture(GL_TEXTURE0 + unit);
+        glBindTexture(target, texture);
+        return;
+    }
+
+    // The unit is selected even when the texture is already bound, texture edits act on the active unit
+    if (Track(m_active_unit, unit))
+    {
+        glActiveTexture(GL_TEXTURE0 + unit);
+    }
+
+    if (Track(m_textures[unit][slot], texture))
+    {
+        glBindTexture(target, texture);
+    }
+}
+
+void StateCache::ForgetProgram(GLuint program)
+{
+    if (m_program == program)
+    {
+        m_program = UNKNOWN;
+    }
+}
+
+void StateCache::ForgetVertexArray(GLuint vao)
+{
+    if (m_vao == vao)
+    {
+        m_vao = UNKNOWN;
+    }
+}
+
+void StateCache::ForgetBuffer(GLuint buffer)
+{
+    for (auto& bound : m_buffers)
+    {
+        bound = bound == buffer ? UNKNOWN : bound;
+    }
+
+    for (auto& binding : m_uniform_bindings)
+    {
+        binding.buffer = binding.buffer == buffer ? UNKNOWN : binding.buffer;
+    }
+}
+
+void StateCache::ForgetFramebuffer(GLuint framebuffer)
+{
+    m_draw_framebuffer = m_draw_framebuffer == framebuffer ? UNKNOWN : m_draw_framebuffer;
+    m_read_framebuffer = m_read_framebuffer == framebuffer ? UNKNOWN : m_read_framebuffer;
+}
+
+void StateCache::ForgetTexture(GLuint texture)
+{
+    for (auto& unit : m_textures)
+    {
+        for (auto& bound : unit)
+        {
+            bound = bound == texture ? UNKNOWN : bound;
+        }
+    }
+}
+
+void StateCache::Invalidate()
+{
+    m_program = UNKNOWN;
+    m_vao = UNKNOWN;
+    m_draw_framebuffer = UNKNOWN;
+    m_read_framebuffer = UNKNOWN;
+    m_active_unit = UNKNOWN;
+
+    m_buffers.fill(UNKNOWN);
+    m_uniform_bindings.fill({ });
+    for (auto& unit : m_textures)
+    {
+        unit.fill(UNKNOWN);
+    }
+}
+
+const StateCache::Counters& StateCache::GetCounters() const noexcept
+{
+    return m_counters;
+}
+
+void StateCache::ResetCounters() noexcept
+{
+    m_counters = { };
+}
+
+bool StateCache::Track(GLuint& cached, GLuint value)
+{
+    if (cached == value)
+    {
+        m_counters.elided++;
+        return false;
+    }
+
+    cached = value;
+    m_counters.issued++;
+    return true;
+}
+
+int StateCache::GetBufferSlot(GLenum target)
+{
+    // GL_ELEMENT_ARRAY_BUFFER is part of the VAO state and is deliberately not tracked
+    switch (target)
+    {
+        case GL_ARRAY_BUFFER: return 0;
+        case GL_UNIFORM_BUFFER: return 1;
+        case GL_PIXEL_PACK_BUFFER: return 2;
+        case GL_PIXEL_UNPACK_BUFFER: return 3;
+        case GL_TEXTURE_BUFFER: return 4;
+        case GL_DRAW_INDIRECT_BUFFER: return 5;
+        case GL_COPY_READ_BUFFER: return 6;
+        case GL_COPY_WRITE_BUFFER: return 7;
+        default: return -1;
+    }
+}
+
+int StateCache::GetTextureSlot(GLenum target)
+{
+    switch (target)
+    {
+        case GL_TEXTURE_1D: return 0;
+        case GL_TEXTURE_2D: return 1;
+        case GL_TEXTURE_BUFFER: return 2;
+        default: return -1;
+    }
+}
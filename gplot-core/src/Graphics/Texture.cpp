@@ -1,4 +1,5 @@
 #include <Graphics/Texture.hpp>
+#include <Graphics/StateCache.hpp>
 
 using namespace gplot::graphics;
 
@@ -6,7 +7,7 @@ Texture::Texture(texsize size, const void* pixels) noexcept
     : m_size(size)
 {
     glGenTextures(1, &m_texture);
-    glBindTexture(GL_TEXTURE_2D, m_texture);
+    StateCache::Get().BindTexture(0, GL_TEXTURE_2D, m_texture);
 
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
@@ -16,11 +17,12 @@ Texture::Texture(texsize size, const void* pixels) noexcept
 
     glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, static_cast<int>(m_size.x), static_cast<int>(m_size.y), 0, GL_RGBA, GL_UNSIGNED_BYTE, pixels);
 
-    glBindTexture(GL_TEXTURE_2D, 0);
+    StateCache::Get().BindTexture(0, GL_TEXTURE_2D, 0);
 }
 
 Texture::~Texture() noexcept
 {
+    StateCache::Get().ForgetTexture(m_texture);
     glDeleteTextures(1, &m_texture);
 }
 
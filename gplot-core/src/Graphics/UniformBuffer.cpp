@@ -0,0 +1,47 @@
+#include <Graphics/UniformBuffer.hpp>
+#include <Graphics/StateCache.hpp>
+
+using namespace gplot::graphics;
+
+UniformBuffer::UniformBuffer(size_t size)
+    : m_size(size)
+{
+    glGenBuffers(1, &m_id);
+    Orphan();
+}
+
+UniformBuffer::~UniformBuffer() noexcept
+{
+    StateCache::Get().ForgetBuffer(m_id);
+    glDeleteBuffers(1, &m_id);
+}
+
+void UniformBuffer::Update(size_t offset, size_t size, const void* data) const
+{
+    StateCache::Get().BindBuffer(GL_UNIFORM_BUFFER, m_id);
+    glBufferSubData(GL_UNIFORM_BUFFER, static_cast<GLintptr>(offset), static_cast<GLsizeiptr>(size), data);
+}
+
+void UniformBuffer::Orphan() const
+{
+    StateCache::Get().BindBuffer(GL_UNIFORM_BUFFER, m_id);
+    glBufferData(GL_UNIFORM_BUFFER, static_cast<GLsizeiptr>(m_size), nullptr, GL_STREAM_DRAW);
+}
+
+void UniformBuffer::BindRange(GLuint binding, size_t offset, size_t size) const
+{
+    StateCache::Get().BindBufferRange(GL_UNIFORM_BUFFER, binding, m_id, static_cast<GLintptr>(offset), static_cast<GLsizeiptr>(size));
+}
+
+size_t UniformBuffer::GetSize() const noexcept
+{
+    return m_size;
+}
+
+size_t UniformBuffer::GetOffsetAlignment()
+{
+    GLint alignment = 0;
+    glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &alignment);
+
+    return alignment > 0 ? static_cast<size_t>(alignment) : 256;
+}
@@ -1,42 +1,42 @@
 #include <Graphics/VertexBuffer.hpp>
+#include <Graphics/StateCache.hpp>
 #include <cstdint>
+#include <iostream>
 
 using namespace gplot::graphics;
 
 namespace
 {
+    // Components of the attribute, 0 for an undefined type
     constexpr size_t GetTypeSize(const VertexBuffer::GeometryBufferAttributes& attr)
     {
-        size_t pure_size = 0;
-        switch (attr.data)
+        return attr.data == VertexBuffer::DataType_t::eUndef ? 0 : attr.data_count;
+    }
+
+    constexpr size_t GetComponentSize(const VertexBuffer::DataType_t type)
+    {
+        switch (type)
         {
             case gplot::graphics::VertexBuffer::DataType_t::eInt32:
             case gplot::graphics::VertexBuffer::DataType_t::eUInt32:
             case gplot::graphics::VertexBuffer::DataType_t::eFloat32:
-                pure_size = 1;
-                break;
+                return sizeof(std::uint32_t);
+            case gplot::graphics::VertexBuffer::DataType_t::eFloat16:
+            case gplot::graphics::VertexBuffer::DataType_t::eInt16:
+            case gplot::graphics::VertexBuffer::DataType_t::eUInt16:
+                return sizeof(std::uint16_t);
+            case gplot::graphics::VertexBuffer::DataType_t::eUInt8:
+                return sizeof(std::uint8_t);
             default:
                 break;
         }
 
-        return pure_size * attr.data_count;
+        return 0;
     }
 
     constexpr size_t GetOffsetStep(const VertexBuffer::GeometryBufferAttributes& attr)
     {
-        size_t data_size = 0;
-        switch (attr.data)
-        {
-            case gplot::graphics::VertexBuffer::DataType_t::eInt32:
-            case gplot::graphics::VertexBuffer::DataType_t::eUInt32:
-            case gplot::graphics::VertexBuffer::DataType_t::eFloat32:
-                data_size = sizeof(std::uint32_t);
-                break;
-            default:
-                break;
-        }
-
-        return data_size * GetTypeSize(attr);
+        return GetComponentSize(attr.data) * GetTypeSize(attr);
     }
 
     constexpr auto EnumToGlType(const VertexBuffer::DataType_t type)
@@ -49,6 +49,14 @@ namespace
                 return GL_UNSIGNED_INT;
             case gplot::graphics::VertexBuffer::DataType_t::eFloat32:
                 return GL_FLOAT;
+            case gplot::graphics::VertexBuffer::DataType_t::eFloat16:
+                return GL_HALF_FLOAT;
+            case gplot::graphics::VertexBuffer::DataType_t::eInt16:
+                return GL_SHORT;
+            case gplot::graphics::VertexBuffer::DataType_t::eUInt16:
+                return GL_UNSIGNED_SHORT;
+            case gplot::graphics::VertexBuffer::DataType_t::eUInt8:
+                return GL_UNSIGNED_BYTE;
             default:
                 break;
         }
@@ -58,96 +66,234 @@ namespace
 
     constexpr bool IsFloatingType(const VertexBuffer::DataType_t type)
     {
-        return EnumToGlType(type) == GL_FLOAT;
+        return EnumToGlType(type) == GL_FLOAT || EnumToGlType(type) == GL_HALF_FLOAT;
     }
 }
 
 VertexBuffer::VertexBuffer(const VertexBufferDescriptor& descriptor)
+    : m_descriptor(descriptor)
 {
     glGenVertexArrays(1, &m_VAO);
-    glBindVertexArray(m_VAO);
+    StateCache::Get().BindVertexArray(m_VAO);
 
-    uint32_t attrib_index = 0;
     m_VBO.resize(descriptor.geometry_buffers.size());
+    m_strides.resize(descriptor.geometry_buffers.size());
     for (int i = 0; i < m_VBO.size(); i++)
     {
         auto& VBO = m_VBO[i];
         const auto& desc = descriptor.geometry_buffers[i];
 
         glGenBuffers(1, &VBO);
-        glBindBuffer(GL_ARRAY_BUFFER, VBO);
+        StateCache::Get().BindBuffer(GL_ARRAY_BUFFER, VBO);
 
         glBufferData(GL_ARRAY_BUFFER, 1, nullptr, GL_DYNAMIC_DRAW);
 
-        GLint total_size = 0;
         for (const auto& element : desc.attributes)
         {
-            total_size += static_cast<GLint>(GetOffsetStep(element));
+            m_strides[i] += GetOffsetStep(element);
         }
 
-        GLuint64 offset = 0;
-        for (const auto& element : desc.attributes)
-        {
-            const auto size = static_cast<GLint>(GetTypeSize(element));
-            if (IsFloatingType(element.data))
-            {
-                const auto norm = element.is_data_normalized ? GL_TRUE : GL_FALSE;
-                glVertexAttribPointer(attrib_index, size, EnumToGlType(element.data), norm, total_size, (const void*)offset);
-            }
-            else
-            {
-                glVertexAttribIPointer(attrib_index, size, EnumToGlType(element.data), total_size, (const void*)offset);
-            }
-            glEnableVertexAttribArray(attrib_index);
-
-            attrib_index++;
-            offset += GetOffsetStep(element);
-        }
+        SetupAttributes(i);
     }
 
-    glBindVertexArray(0);
+    glGenVertexArrays(1, &m_instance_VAO);
+    SetupInstanceAttributes();
+
+    StateCache::Get().BindVertexArray(0);
 }
 
 VertexBuffer::~VertexBuffer() noexcept
 {
+    ReleasePersistentStorage();
+
     for (auto& VBO : m_VBO)
     {
+        StateCache::Get().ForgetBuffer(VBO);
         glDeleteBuffers(1, &VBO);
     }
 
+    StateCache::Get().ForgetVertexArray(m_VAO);
     glDeleteVertexArrays(1, &m_VAO);
+
+    StateCache::Get().ForgetVertexArray(m_instance_VAO);
+    glDeleteVertexArrays(1, &m_instance_VAO);
 }
 
 void VertexBuffer::Bind() const
 {
-    glBindVertexArray(m_VAO);
+    StateCache::Get().BindVertexArray(m_VAO);
+}
+
+void VertexBuffer::BindInstanceAttributes() const
+{
+    StateCache::Get().BindVertexArray(m_instance_VAO);
 }
 
 void VertexBuffer::Unbind()
 {
-    glBindVertexArray(0);
+    StateCache::Get().BindVertexArray(0);
 }
 
 void VertexBuffer::UnmapBuffer(int id) const
 {
-    glBindBuffer(GL_ARRAY_BUFFER, m_VBO[id]);
+    StateCache::Get().BindBuffer(GL_ARRAY_BUFFER, m_VBO[id]);
     glUnmapBuffer(GL_ARRAY_BUFFER);
 }
 
 void VertexBuffer::Resize(int id, size_t size) const
 {
-    glBindBuffer(GL_ARRAY_BUFFER, m_VBO[id]);
+    StateCache::Get().BindBuffer(GL_ARRAY_BUFFER, m_VBO[id]);
     glBufferData(GL_ARRAY_BUFFER, static_cast<GLsizeiptr>(size), nullptr, GL_DYNAMIC_DRAW);
 }
 
-void VertexBuffer::Update(int id, size_t size, const void* data, int offset) const
+void VertexBuffer::Update(int id, size_t size, const void* data, size_t offset) const
+{
+    StateCache::Get().BindBuffer(GL_ARRAY_BUFFER, m_VBO[id]);
+    glBufferSubData(GL_ARRAY_BUFFER, static_cast<GLintptr>(offset), static_cast<GLsizeiptr>(size), data);
+}
+
+GLuint VertexBuffer::GetBufferId(int id) const noexcept
 {
-    glBindBuffer(GL_ARRAY_BUFFER, m_VBO[id]);
-    glBufferSubData(GL_ARRAY_BUFFER, offset, static_cast<GLsizeiptr>(size), data);
+    return m_VBO[id];
 }
 
 void* VertexBuffer::MapBufferInternal(int id, size_t offset, size_t length, GLbitfield flags) const
 {
-    glBindBuffer(GL_ARRAY_BUFFER, m_VBO[id]);
+    StateCache::Get().BindBuffer(GL_ARRAY_BUFFER, m_VBO[id]);
     return glMapBufferRange(GL_ARRAY_BUFFER, static_cast<GLintptr>(offset), static_cast<GLintptr>(length), flags);
 }
+
+bool VertexBuffer::IsPersistentStorageSupported()
+{
+    return GLAD_GL_VERSION_4_4 != 0;
+}
+
+void VertexBuffer::CreatePersistentStorage(size_t region_vertex_count, size_t regions)
+{
+    ReleasePersistentStorage();
+
+    // Immutable storage cannot be resized, so every buffer is recreated and re-attached to the VAO
+    StateCache::Get().BindVertexArray(m_VAO);
+
+    constexpr GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+    m_persistent_ptrs.resize(m_VBO.size());
+    for (size_t i = 0; i < m_VBO.size(); i++)
+    {
+        const auto size = static_cast<GLsizeiptr>(m_strides[i] * region_vertex_count * regions);
+
+        StateCache::Get().ForgetBuffer(m_VBO[i]);
+        glDeleteBuffers(1, &m_VBO[i]);
+        glGenBuffers(1, &m_VBO[i]);
+        StateCache::Get().BindBuffer(GL_ARRAY_BUFFER, m_VBO[i]);
+        glBufferStorage(GL_ARRAY_BUFFER, size, nullptr, flags);
+
+        m_persistent_ptrs[i] = static_cast<char*>(glMapBufferRange(GL_ARRAY_BUFFER, 0, size, flags));
+        SetupAttributes(static_cast<int>(i));
+    }
+
+    SetupInstanceAttributes();
+
+    StateCache::Get().BindVertexArray(0);
+
+    m_persistent_fences.assign(regions, nullptr);
+    m_persistent_region = 0;
+    m_persistent_capacity = region_vertex_count;
+}
+
+size_t VertexBuffer::BeginPersistentRegion()
+{
+    m_persistent_region = (m_persistent_region + 1) % m_persistent_fences.size();
+
+    auto& fence = m_persistent_fences[m_persistent_region];
+    if (fence)
+    {
+        // Only blocks when the CPU got a full ring of regions ahead of the GPU
+        GLenum status = GL_TIMEOUT_EXPIRED;
+        while (status == GL_TIMEOUT_EXPIRED)
+        {
+            status = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1'000'000);
+        }
+
+        // The GPU may still read the region, finishing is the only other way to know it is free
+        if (status == GL_WAIT_FAILED)
+        {
+            std::cerr << __FILE__ << ":" << __LINE__ << " Failed to wait for a persistent region fence" << std::endl;
+            glFinish();
+        }
+
+        glDeleteSync(fence);
+        fence = nullptr;
+    }
+
+    return m_persistent_region * m_persistent_capacity;
+}
+
+void VertexBuffer::EndPersistentRegion()
+{
+    m_persistent_fences[m_persistent_region] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+}
+
+size_t VertexBuffer::GetPersistentRegionCapacity() const noexcept
+{
+    return m_persistent_capacity;
+}
+
+void VertexBuffer::SetupAttributes(int id) const
+{
+    GLuint attrib_index = 0;
+    for (int i = 0; i < id; i++)
+    {
+        attrib_index += static_cast<GLuint>(m_descriptor.geometry_buffers[i].attributes.size());
+    }
+
+    StateCache::Get().BindBuffer(GL_ARRAY_BUFFER, m_VBO[id]);
+
+    GLuint64 offset = 0;
+    const auto total_size = static_cast<GLint>(m_strides[id]);
+    for (const auto& element : m_descriptor.geometry_buffers[id].attributes)
+    {
+        const auto size = static_cast<GLint>(GetTypeSize(element));
+        if (IsFloatingType(element.data) || element.is_data_normalized)
+        {
+            const auto norm = element.is_data_normalized ? GL_TRUE : GL_FALSE;
+            glVertexAttribPointer(attrib_index, size, EnumToGlType(element.data), norm, total_size, (const void*)offset);
+        }
+        else
+        {
+            glVertexAttribIPointer(attrib_index, size, EnumToGlType(element.data), total_size, (const void*)offset);
+        }
+        glEnableVertexAttribArray(attrib_index);
+        glVertexAttribDivisor(attrib_index, m_descriptor.geometry_buffers[id].divisor);
+
+        attrib_index++;
+        offset += GetOffsetStep(element);
+    }
+}
+
+void VertexBuffer::SetupInstanceAttributes() const
+{
+    StateCache::Get().BindVertexArray(m_instance_VAO);
+    for (size_t i = 0; i < m_VBO.size(); i++)
+    {
+        if (m_descriptor.geometry_buffers[i].divisor != 0)
+        {
+            SetupAttributes(static_cast<int>(i));
+        }
+    }
+}
+
+void VertexBuffer::ReleasePersistentStorage()
+{
+    for (auto& fence : m_persistent_fences)
+    {
+        if (fence)
+        {
+            glDeleteSync(fence);
+        }
+    }
+
+    m_persistent_fences.clear();
+    m_persistent_ptrs.clear();
+    m_persistent_capacity = 0;
+    m_persistent_region = 0;
+}
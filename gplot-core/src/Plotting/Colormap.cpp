@@ -0,0 +1,87 @@
+#include <Plotting/Colormap.hpp>
+
+#include <Graphics/StateCache.hpp>
+
+#include <span>
+#include <array>
+#include <cmath>
+#include <algorithm>
+
+using namespace gplot;
+
+namespace
+{
+    // Evenly spaced 0xRRGGBB stops, the perceptual maps are the nine-step matplotlib palettes
+    constexpr std::array<std::uint32_t, 9> VIRIDIS { 0x440154, 0x472D7B, 0x3B528B, 0x2C728E, 0x21918C, 0x28AE80, 0x5EC962, 0xADDC30, 0xFDE725 };
+    constexpr std::array<std::uint32_t, 9> MAGMA   { 0x000004, 0x1C1044, 0x4F127B, 0x812581, 0xB5367A, 0xE55064, 0xFB8761, 0xFEC287, 0xFCFDBF };
+    constexpr std::array<std::uint32_t, 9> INFERNO { 0x000004, 0x1F0C48, 0x550F6D, 0x88226A, 0xBA3655, 0xE35933, 0xF98E09, 0xF9CB35, 0xFCFFA4 };
+    constexpr std::array<std::uint32_t, 9> PLASMA  { 0x0D0887, 0x4C02A1, 0x7E03A8, 0xA92395, 0xCC4778, 0xE56B5D, 0xF89540, 0xFDC328, 0xF0F921 };
+    constexpr std::array<std::uint32_t, 2> GRAYSCALE { 0x000000, 0xFFFFFF };
+
+    std::span<const std::uint32_t> GetStops(Colormap colormap)
+    {
+        switch (colormap)
+        {
+            case Colormap::eViridis:   return VIRIDIS;
+            case Colormap::eMagma:     return MAGMA;
+            case Colormap::eInferno:   return INFERNO;
+            case Colormap::ePlasma:    return PLASMA;
+            case Colormap::eGrayscale: return GRAYSCALE;
+        }
+
+        return VIRIDIS;
+    }
+
+    float GetChannel(std::uint32_t stop, int shift)
+    {
+        return static_cast<float>((stop >> shift) & 0xFFU);
+    }
+}
+
+std::vector<std::uint8_t> gplot::SampleColormap(Colormap colormap, size_t count)
+{
+    const auto stops = GetStops(colormap);
+
+    std::vector<std::uint8_t> rgba(count * 4);
+    for (size_t i = 0; i < count; i++)
+    {
+        const float position = count > 1 ? static_cast<float>(i) / static_cast<float>(count - 1) * static_cast<float>(stops.size() - 1) : 0.0F;
+        const size_t lower = std::min(static_cast<size_t>(position), stops.size() - 2);
+        const float t = position - static_cast<float>(lower);
+
+        for (int channel = 0; channel < 3; channel++)
+        {
+            const int shift = 16 - channel * 8;
+            const float value = GetChannel(stops[lower], shift) * (1.0F - t) + GetChannel(stops[lower + 1], shift) * t;
+            rgba[i * 4 + channel] = static_cast<std::uint8_t>(std::lround(value));
+        }
+        rgba[i * 4 + 3] = 0xFF;
+    }
+
+    return rgba;
+}
+
+ColormapTexture::ColormapTexture(Colormap colormap)
+{
+    const auto rgba = SampleColormap(colormap, SIZE);
+
+    glGenTextures(1, &m_texture);
+    gplot::graphics::StateCache::Get().BindTexture(0, GL_TEXTURE_1D, m_texture);
+
+    glTexParameteri(GL_TEXTURE_1D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_1D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_1D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+
+    glTexImage1D(GL_TEXTURE_1D, 0, GL_RGBA8, static_cast<GLsizei>(SIZE), 0, GL_RGBA, GL_UNSIGNED_BYTE, rgba.data());
+}
+
+ColormapTexture::~ColormapTexture() noexcept
+{
+    gplot::graphics::StateCache::Get().ForgetTexture(m_texture);
+    glDeleteTextures(1, &m_texture);
+}
+
+GLuint ColormapTexture::GetTextureId() const noexcept
+{
+    return m_texture;
+}
@@ -0,0 +1,159 @@
+#include <Plotting/Decimation.hpp>
+#include <Core/ThreadPool.hpp>
+
+#include <cmath>
+#include <array>
+#include <algorithm>
+
+using namespace gplot;
+
+ColumnMapping::ColumnMapping(float x_min, float x_max, int columns)
+    : x_min(x_min)
+    , scale(static_cast<float>(columns) / (x_max - x_min))
+    , columns(columns)
+{
+
+}
+
+int ColumnMapping::operator()(float x) const
+{
+    // clamp passes NaN through, and converting it to int is undefined
+    const float column = std::floor((x - x_min) * scale);
+    if (std::isnan(column))
+    {
+        return columns;
+    }
+
+    return static_cast<int>(std::clamp(column, -1.0F, static_cast<float>(columns)));
+}
+
+void gplot::EmitMinMax(std::span<const gplot::core::Vertex> vertices, const MinMaxSummary& summary, std::vector<gplot::core::Vertex>& output)
+{
+    std::array<size_t, 4> indices { summary.first, summary.min, summary.max, summary.last };
+    std::sort(indices.begin() + 1, indices.begin() + 3);
+
+    size_t previous = indices[0];
+    output.push_back(vertices[previous]);
+    for (size_t i = 1; i < indices.size(); i++)
+    {
+        if (indices[i] != previous)
+        {
+            previous = indices[i];
+            output.push_back(vertices[previous]);
+        }
+    }
+}
+
+void gplot::DecimateMinMax(std::span<const gplot::core::Vertex> vertices, float x_min, float x_max, int columns, std::vector<gplot::core::Vertex>& output)
+{
+    output.clear();
+    if (vertices.empty() || columns <= 0 || !(x_max > x_min))
+    {
+        output.assign(vertices.begin(), vertices.end());
+        return;
+    }
+
+    const ColumnMapping column_of(x_min, x_max, columns);
+
+    output.reserve(std::min(vertices.size(), static_cast<size_t>(columns + 2) * 4));
+
+    MinMaxSummary summary;
+    int current = column_of(vertices[0].pos.x);
+    for (size_t i = 1; i < vertices.size(); i++)
+    {
+        const int column = column_of(vertices[i].pos.x);
+        if (column != current)
+        {
+            EmitMinMax(vertices, summary, output);
+
+            current = column;
+            summary = { i, i, i, i };
+            continue;
+        }
+
+        summary.last = i;
+        if (vertices[i].pos.y < vertices[summary.min].pos.y)
+        {
+            summary.min = i;
+        }
+        if (vertices[i].pos.y > vertices[summary.max].pos.y)
+        {
+            summary.max = i;
+        }
+    }
+
+    EmitMinMax(vertices, summary, output);
+}
+
+void gplot::DecimateLTTB(std::span<const gplot::core::Vertex> vertices, size_t target, std::vector<gplot::core::Vertex>& output)
+{
+    output.clear();
+    if (target < 3 || vertices.size() <= target)
+    {
+        output.assign(vertices.begin(), vertices.end());
+        return;
+    }
+
+    output.reserve(target);
+    output.push_back(vertices.front());
+
+    // The first and last vertices are always kept, the rest is split into target - 2 buckets
+    const double every = static_cast<double>(vertices.size() - 2) / static_cast<double>(target - 2);
+    const auto bucket_start = [&](size_t bucket)
+    {
+        return std::min(static_cast<size_t>(static_cast<double>(bucket) * every) + 1, vertices.size() - 1);
+    };
+
+    size_t selected = 0;
+    for (size_t bucket = 0; bucket < target - 2; bucket++)
+    {
+        const size_t begin = bucket_start(bucket);
+        const size_t end = bucket_start(bucket + 1);
+
+        // The third triangle vertex is the average of the next bucket, or the last vertex for the final bucket
+        const size_t next_begin = end;
+        const size_t next_end = std::max(bucket_start(bucket + 2), next_begin + 1);
+
+        glm::vec2 average { 0.0F };
+        for (size_t i = next_begin; i < next_end; i++)
+        {
+            average += vertices[i].pos;
+        }
+        average /= static_cast<float>(next_end - next_begin);
+
+        const glm::vec2 anchor = vertices[selected].pos;
+
+        float max_area = -1.0F;
+        size_t max_index = begin;
+        for (size_t i = begin; i < end; i++)
+        {
+            const glm::vec2 point = vertices[i].pos;
+            const float area = glm::abs((anchor.x - average.x) * (point.y - anchor.y) - (anchor.x - point.x) * (average.y - anchor.y));
+            if (area > max_area)
+            {
+                max_area = area;
+                max_index = i;
+            }
+        }
+
+        output.push_back(vertices[max_index]);
+        selected = max_index;
+    }
+
+    output.push_back(vertices.back());
+}
+
+std::vector<std::vector<gplot::core::Vertex>> gplot::DecimateLTTB(const std::vector<std::vector<gplot::core::Vertex>>& lines, size_t target)
+{
+    std::vector<std::vector<gplot::core::Vertex>> result(lines.size());
+
+    gplot::core::ThreadPool::GetDefault().ParallelFor(lines.size(), 1, [&](size_t begin, size_t end)
+    {
+        for (size_t i = begin; i < end; i++)
+        {
+            DecimateLTTB(lines[i], target, result[i]);
+        }
+    });
+
+    return result;
+}
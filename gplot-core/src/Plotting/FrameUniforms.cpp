@@ -0,0 +1,37 @@
+#include <Plotting/FrameUniforms.hpp>
+
+#include <algorithm>
+
+using namespace gplot;
+
+namespace
+{
+    size_t AlignUp(size_t value, size_t alignment)
+    {
+        return (value + alignment - 1) / alignment * alignment;
+    }
+}
+
+FrameUniforms::FrameUniforms(size_t capacity)
+    : m_stride(AlignUp(sizeof(Block), gplot::graphics::UniformBuffer::GetOffsetAlignment()))
+    , m_capacity(std::max<size_t>(capacity, 1))
+    , m_buffer(m_stride * m_capacity)
+{
+    static_assert(sizeof(Block) == 80, "FrameUniforms::Block has to match the std140 FrameData block");
+}
+
+void FrameUniforms::Push(const Block& block)
+{
+    // Draws of earlier blocks may still be in flight, a full buffer gets fresh storage instead of being overwritten
+    if (m_next == m_capacity)
+    {
+        m_buffer.Orphan();
+        m_next = 0;
+    }
+
+    const size_t offset = m_next * m_stride;
+    m_buffer.Update(offset, sizeof(Block), &block);
+    m_buffer.BindRange(BINDING, offset, sizeof(Block));
+
+    m_next++;
+}
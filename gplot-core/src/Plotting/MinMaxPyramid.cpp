@@ -0,0 +1,206 @@
+#include <Plotting/MinMaxPyramid.hpp>
+
+#include <Core/ThreadPool.hpp>
+
+#include <limits>
+#include <algorithm>
+
+using namespace gplot;
+
+namespace
+{
+    constexpr size_t PARALLEL_GRAIN = 1 << 14;
+
+    MinMaxPyramid::Bucket Summarize(std::span<const gplot::core::Vertex> vertices, size_t begin, size_t end)
+    {
+        MinMaxPyramid::Bucket bucket;
+        bucket.first = static_cast<std::uint32_t>(begin);
+        bucket.last = static_cast<std::uint32_t>(end - 1);
+
+        size_t min = begin;
+        size_t max = begin;
+        for (size_t i = begin + 1; i < end; i++)
+        {
+            min = vertices[i].pos.y < vertices[min].pos.y ? i : min;
+            max = vertices[i].pos.y > vertices[max].pos.y ? i : max;
+        }
+
+        bucket.min = static_cast<std::uint32_t>(min);
+        bucket.max = static_cast<std::uint32_t>(max);
+        return bucket;
+    }
+
+    MinMaxPyramid::Bucket Merge(std::span<const gplot::core::Vertex> vertices, std::span<const MinMaxPyramid::Bucket> children)
+    {
+        MinMaxPyramid::Bucket bucket = children.front();
+        bucket.last = children.back().last;
+
+        for (const auto& child : children.subspan(1))
+        {
+            bucket.min = vertices[child.min].pos.y < vertices[bucket.min].pos.y ? child.min : bucket.min;
+            bucket.max = vertices[child.max].pos.y > vertices[bucket.max].pos.y ? child.max : bucket.max;
+        }
+
+        return bucket;
+    }
+}
+
+void MinMaxPyramid::Build(std::span<const gplot::core::Vertex> vertices)
+{
+    Clear();
+    Extend(vertices, 0);
+}
+
+void MinMaxPyramid::Extend(std::span<const gplot::core::Vertex> vertices, size_t previous_size)
+{
+    if (vertices.size() > std::numeric_limits<std::uint32_t>::max())
+    {
+        Clear();
+        return;
+    }
+
+    auto& pool = gplot::core::ThreadPool::GetDefault();
+
+    // The last bucket of every level may have been partial, so it is always recomputed
+    size_t dirty = previous_size / BASE_BUCKET;
+    size_t count = (vertices.size() + BASE_BUCKET - 1) / BASE_BUCKET;
+
+    if (m_levels.empty())
+    {
+        m_levels.emplace_back();
+    }
+
+    m_levels[0].resize(count);
+    pool.ParallelFor(count - std::min(dirty, count), PARALLEL_GRAIN, [&](size_t begin, size_t end)
+    {
+        for (size_t i = dirty + begin; i < dirty + end; i++)
+        {
+            m_levels[0][i] = Summarize(vertices, i * BASE_BUCKET, std::min(vertices.size(), (i + 1) * BASE_BUCKET));
+        }
+    });
+
+    for (size_t level = 1; count > 1; level++)
+    {
+        dirty /= FANOUT;
+        count = (m_levels[level - 1].size() + FANOUT - 1) / FANOUT;
+
+        if (m_levels.size() <= level)
+        {
+            m_levels.emplace_back();
+        }
+
+        auto& buckets = m_levels[level];
+        const auto& source = m_levels[level - 1];
+
+        buckets.resize(count);
+        pool.ParallelFor(count - std::min(dirty, count), PARALLEL_GRAIN, [&](size_t begin, size_t end)
+        {
+            for (size_t i = dirty + begin; i < dirty + end; i++)
+            {
+                const size_t first = i * FANOUT;
+                buckets[i] = Merge(vertices, std::span(source).subspan(first, std::min(FANOUT, source.size() - first)));
+            }
+        });
+    }
+}
+
+void MinMaxPyramid::Clear()
+{
+    m_levels.clear();
+}
+
+bool MinMaxPyramid::IsEmpty() const noexcept
+{
+    return m_levels.empty();
+}
+
+size_t MinMaxPyramid::GetLevelCount() const noexcept
+{
+    return m_levels.size();
+}
+
+int MinMaxPyramid::ChooseLevel(std::span<const gplot::core::Vertex> vertices, float x_min, float x_max, int columns) const
+{
+    if (m_levels.empty() || vertices.empty() || columns <= 0)
+    {
+        return -1;
+    }
+
+    const float pixel = (x_max - x_min) / static_cast<float>(columns);
+    const float extent = vertices.back().pos.x - vertices.front().pos.x;
+
+    for (int level = static_cast<int>(m_levels.size()) - 1; level >= 0; level--)
+    {
+        if (extent / static_cast<float>(m_levels[level].size()) <= pixel)
+        {
+            return level;
+        }
+    }
+
+    return -1;
+}
+
+void MinMaxPyramid::Collect(std::span<const gplot::core::Vertex> vertices, float x_min, float x_max, int columns, std::vector<gplot::core::Vertex>& output) const
+{
+    output.clear();
+    if (m_levels.empty() || vertices.empty())
+    {
+        output.assign(vertices.begin(), vertices.end());
+        return;
+    }
+
+    const int level = ChooseLevel(vertices, x_min, x_max, columns);
+    const auto& buckets = m_levels[std::max(level, 0)];
+
+    auto lo = std::lower_bound(buckets.begin(), buckets.end(), x_min, [&](const Bucket& bucket, float x)
+    {
+        return vertices[bucket.last].pos.x < x;
+    });
+
+    auto hi = std::upper_bound(lo, buckets.end(), x_max, [&](float x, const Bucket& bucket)
+    {
+        return x < vertices[bucket.first].pos.x;
+    });
+
+    lo = lo == buckets.begin() ? lo : lo - 1;
+    hi = hi == buckets.end() ? hi : hi + 1;
+
+    if (level < 0)
+    {
+        const auto first = vertices.begin() + lo->first;
+        const auto last = vertices.begin() + (hi - 1)->last + 1;
+        output.assign(first, last);
+        return;
+    }
+
+    const ColumnMapping column_of(x_min, x_max, columns);
+
+    output.reserve(static_cast<size_t>(hi - lo) * 4);
+    for (auto it = lo; it != hi; ++it)
+    {
+        CollectBucket(vertices, level, static_cast<size_t>(it - buckets.begin()), column_of, output);
+    }
+}
+
+void MinMaxPyramid::CollectBucket(std::span<const gplot::core::Vertex> vertices, size_t level, size_t index, const ColumnMapping& column_of, std::vector<gplot::core::Vertex>& output) const
+{
+    const auto& bucket = m_levels[level][index];
+    if (column_of(vertices[bucket.first].pos.x) == column_of(vertices[bucket.last].pos.x))
+    {
+        EmitMinMax(vertices, { bucket.first, bucket.min, bucket.max, bucket.last }, output);
+        return;
+    }
+
+    if (level == 0)
+    {
+        output.insert(output.end(), vertices.begin() + bucket.first, vertices.begin() + bucket.last + 1);
+        return;
+    }
+
+    const size_t first = index * FANOUT;
+    const size_t last = std::min(first + FANOUT, m_levels[level - 1].size());
+    for (size_t child = first; child < last; child++)
+    {
+        CollectBucket(vertices, level - 1, child, column_of, output);
+    }
+}
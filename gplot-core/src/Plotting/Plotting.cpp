@@ -1,12 +1,54 @@
-#include <Core/DriveIO.hpp>
 #include <Plotting/Plotting.hpp>
+#include <Plotting/Decimation.hpp>
+
+#include <Core/ThreadPool.hpp>
+#include <Graphics/ShaderSources.hpp>
 
 #include <glm/gtc/matrix_transform.hpp>
 
+#include <array>
+#include <limits>
+#include <iostream>
+#include <algorithm>
+
 using namespace gplot;
 
 namespace
 {
+    // Texels a buffer texture must address for eAuto to pick the instanced pipeline
+    constexpr GLint MIN_INSTANCED_TEXELS = 1 << 24;
+
+    // Leading ring vertices mirrored past the end, so a wrapped strip keeps the adjacency of the seam
+    constexpr size_t RING_PADDING = 3;
+
+    // Attribute divisor of the per-series color table, no draw has enough instances to advance past its base entry
+    constexpr GLuint PER_SERIES_DIVISOR = 1U << 31;
+
+    // Per-series block of the colormap shaders, std140 layout of "SeriesData"
+    constexpr GLuint SERIES_DATA_BINDING = 1;
+
+    struct SeriesData
+    {
+        glm::vec2 value_range { 0.0F };
+        glm::vec2 padding { 0.0F };
+    };
+
+    // Units 0 and 1 hold the instanced pipeline's buffer textures
+    constexpr GLuint COLORMAP_UNIT = 2;
+
+    // Segments per precise chunk, a chunk slot also holds the three adjacency vertices around them
+    constexpr size_t PRECISE_CHUNK = 4096;
+    constexpr size_t PRECISE_SLOT = PRECISE_CHUNK + 3;
+
+    // Float rounding of precise vertices near the view, in pixels, tolerated before their chunk moves onto the camera
+    constexpr double PRECISE_PIXEL_ERROR = 0.25;
+
+    // Canvas size assumed by precise series while the plotter does not know its own
+    constexpr int DEFAULT_CANVAS_SIZE = 4096;
+
+    // Steps of a normalized 16-bit coordinate
+    constexpr double QUANTIZED_STEPS = 65535.0;
+
     std::uint32_t VecToInt32(glm::vec4 color)
     {
         std::uint32_t res = 0;
@@ -17,155 +59,1668 @@ namespace
 
         return res;
     }
+
+    // Index range of an x-sorted series covering [x_min, x_max]. Two vertices of padding on each side keep the segments
+    // entering and leaving the view, since a strip-adjacency primitive also needs the vertex before its segment.
+    template<typename F>
+    std::pair<size_t, size_t> FindVisibleRange(size_t count, float x_min, float x_max, F&& x_at)
+    {
+        const auto partition = [&](auto&& predicate)
+        {
+            size_t lo = 0;
+            size_t hi = count;
+            while (lo < hi)
+            {
+                const size_t mid = lo + (hi - lo) / 2;
+                if (predicate(x_at(mid)))
+                {
+                    lo = mid + 1;
+                }
+                else
+                {
+                    hi = mid;
+                }
+            }
+
+            return lo;
+        };
+
+        const size_t begin = partition([&](float x) { return x < x_min; });
+        const size_t end = partition([&](float x) { return x <= x_max; });
+
+        return { begin > 2 ? begin - 2 : 0, std::min(count, end + 2) };
+    }
+
+    glm::vec2 GetViewRange(const CameraViewport& camera)
+    {
+        return glm::vec2(camera.center.x - camera.proportions.x / 2, camera.center.x + camera.proportions.x / 2);
+    }
+
+    glm::mat4 MakeViewMatrix(const CameraViewport& camera)
+    {
+        return glm::mat4(glm::ortho(camera.center.x - camera.proportions.x / 2,
+                                    camera.center.x + camera.proportions.x / 2,
+                                    camera.center.y - camera.proportions.y / 2,
+                                    camera.center.y + camera.proportions.y / 2));
+    }
+
+    // View matrix of data stored relative to `origin`, the translation to the eye is resolved in double precision
+    glm::mat4 MakeRelativeViewMatrix(const CameraViewport& camera, glm::dvec2 origin)
+    {
+        const glm::dvec2 half = camera.proportions / 2.0;
+        const glm::dmat4 projection = glm::ortho(-half.x, half.x, -half.y, half.y);
+
+        return glm::mat4(glm::translate(projection, glm::dvec3(origin - camera.center, 0.0)));
+    }
 }
 
-Plotter::Plotter()
-    : m_buffer(CreateVertexBuffer())
-    , m_grid_buffer(CreateVertexBuffer())
-    , m_shader(LoadLineShader())
+Plotter::Plotter(const PlotterDescriptor& descriptor)
+    : m_descriptor(descriptor)
+    , m_line_pipeline(ResolveLinePipeline(descriptor.line_pipeline))
+    , m_per_series_colors(ResolvePerSeriesColors(descriptor))
+    , m_chunk_encoding(descriptor.chunk_encoding)
+    , m_max_texels(static_cast<size_t>(std::max(gplot::graphics::BufferTexture::GetMaxTexels(), 0)))
+    , m_shader(LoadLineShader(m_line_pipeline))
+    , m_series_shader(LoadSeriesShader(m_line_pipeline, m_per_series_colors))
     , m_grid_shader(LoadGridShader())
+    , m_buffer(CreateVertexBuffer())
+    , m_grid_buffer(CreateVertexBuffer())
+    , m_series_buffer(CreateVertexBuffer(m_per_series_colors))
 {
+    m_frame_uniforms = m_descriptor.frame_uniforms ? m_descriptor.frame_uniforms : std::make_shared<FrameUniforms>();
 
+    m_shader->BindUniformBlock("FrameData", FrameUniforms::BINDING);
+    m_grid_shader.BindUniformBlock("FrameData", FrameUniforms::BINDING);
+
+    if (m_line_pipeline == LinePipeline::eInstanced)
+    {
+        m_shader->Use();
+        m_shader->Set("uPositions", 0);
+        m_shader->Set("uColors", 1);
+    }
+
+    if (m_series_shader)
+    {
+        m_series_shader->BindUniformBlock("FrameData", FrameUniforms::BINDING);
+
+        m_series_shader->Use();
+        m_series_shader->Set("uPositions", 0);
+    }
+
+    m_persistent_buffer = m_descriptor.persistent_buffers
+                       && m_descriptor.persistent_regions > 0
+                       && gplot::graphics::VertexBuffer::IsPersistentStorageSupported();
+
+    m_indirect_draws = m_descriptor.indirect_draws && gplot::graphics::IndirectBuffer::IsSupported();
 }
 
 void Plotter::PlotLines(const std::vector<std::vector<gplot::core::Vertex>>& lines, const std::vector<glm::vec4>& colors, core::RectF bounds, CameraViewport camera, float line_thickness, float line_feather)
 {
-    glm::mat4 view_matrix = glm::ortho(camera.center.x - camera.proportions.x / 2,
-                                       camera.center.x + camera.proportions.x / 2,
-                                       camera.center.y - camera.proportions.y / 2,
-                                       camera.center.y + camera.proportions.y / 2);
+    m_frame_uniforms->Push({ MakeViewMatrix(camera), line_thickness, line_feather });
 
     m_grid_shader.Use();
-    m_grid_shader.Set("uViewMatrix", view_matrix);
     RenderGrid(bounds, 10, 10);
 
-    m_shader.Use();
-    m_shader.Set("uViewMatrix", view_matrix);
+    if (m_persistent_buffer)
+    {
+        PlotLinesPersistent(lines, colors);
+    }
+    else
+    {
+        PlotLinesInternal(lines, colors, m_buffer);
+    }
+}
+
+SeriesHandle Plotter::AddSeries(std::vector<gplot::core::Vertex> vertices, glm::vec4 color)
+{
+    const auto handle = AllocateSeries();
 
-    m_shader.Set("uFeather", line_feather);
-    m_shader.Set("uLineThickness", line_thickness);
+    auto& series = *FindSeries(handle);
+    series.color = color;
+    series.vertices = std::move(vertices);
 
-    PlotLinesInternal(lines, colors, m_buffer);
+    m_series_layout_dirty = true;
+    return handle;
 }
 
-void Plotter::RenderGrid(core::RectF bounds, int count_x, int count_y) const
+void Plotter::UpdateSeries(SeriesHandle handle, std::vector<gplot::core::Vertex> vertices)
 {
-    std::vector<std::vector<gplot::core::Vertex>> lines;
-    lines.reserve(count_x + count_y);
+    auto* series = FindSeries(handle);
+    if (!series)
+    {
+        return;
+    }
 
-    auto step_x = glm::abs(bounds.min.x - bounds.max.x) / static_cast<float>(count_x);
-    auto step_y = glm::abs(bounds.min.y - bounds.max.y) / static_cast<float>(count_y);
+    if (series->ring)
+    {
+        series->ring_head = 0;
+        series->ring_size = 0;
+        WriteRing(*series, vertices);
+        return;
+    }
 
-    std::vector<gplot::core::Vertex> curr;
-    for (int i = 0; i < count_x + 1; i++)
+    if (series->mapped)
     {
-        curr.resize(4);
-        curr[0] = { glm::vec2(bounds.min.x + step_x * static_cast<float>(i), bounds.min.y) };
-        curr[1] = { glm::vec2(bounds.min.x + step_x * static_cast<float>(i), bounds.min.y) };
-        curr[2] = { glm::vec2(bounds.min.x + step_x * static_cast<float>(i), bounds.max.y) };
-        curr[3] = { glm::vec2(bounds.min.x + step_x * static_cast<float>(i), bounds.max.y) };
-        lines.push_back(curr);
+        series->vertices = std::move(vertices);
+        series->mapped_dirty = true;
+        return;
     }
 
-    for (int i = 0; i < count_y + 1; i++)
+    if (series->precise)
     {
-        curr.resize(4);
-        curr[0] = { glm::vec2(bounds.min.x, bounds.min.y + step_y * static_cast<float>(i)) };
-        curr[1] = { glm::vec2(bounds.min.x, bounds.min.y + step_y * static_cast<float>(i)) };
-        curr[2] = { glm::vec2(bounds.max.x, bounds.min.y + step_y * static_cast<float>(i)) };
-        curr[3] = { glm::vec2(bounds.max.x, bounds.min.y + step_y * static_cast<float>(i)) };
-        lines.push_back(curr);
+        std::vector<glm::dvec2> points(vertices.size());
+        std::transform(vertices.begin(), vertices.end(), points.begin(), [](const gplot::core::Vertex& vertex) { return glm::dvec2(vertex.pos); });
+        UpdatePreciseSeries(handle, std::move(points));
+        return;
     }
 
-    glm::vec4 color = { 0.3F, 0.3F, 0.3F, 1.0F };
-    PlotLinesInternal(lines, std::vector<glm::vec4>(lines.size(), color), m_grid_buffer);
+    // Same-sized updates are patched in place, anything else requires the packed buffer to be rebuilt
+    const bool in_place = !m_series_layout_dirty && series->decimation == Decimation::eNone && series->vertices.size() == vertices.size();
+    series->vertices = std::move(vertices);
+    series->view_dirty = true;
+
+    if (series->decimation == Decimation::eMinMax)
+    {
+        series->pyramid.Build(series->vertices);
+    }
+
+    if (!in_place)
+    {
+        m_series_layout_dirty = true;
+        return;
+    }
+
+    if (!series->vertices.empty())
+    {
+        m_series_buffer.Update(0, sizeof(gplot::core::Vertex) * series->vertices.size(), series->vertices.data(), sizeof(gplot::core::Vertex) * series->first);
+    }
+
+    // The culled first/count of a sorted series came from the old x values
+    m_series_draws_dirty |= series->sorted_x;
 }
 
-gplot::graphics::Shader Plotter::LoadGridShader()
+void Plotter::SetSeriesColor(SeriesHandle handle, glm::vec4 color)
 {
-    gplot::core::DriveIO disk_io;
+    auto* series = FindSeries(handle);
+    if (!series)
+    {
+        return;
+    }
+
+    series->color = color;
+    if (series->ring)
+    {
+        FillRingColor(*series);
+        return;
+    }
+
+    if (series->mapped)
+    {
+        return;
+    }
+
+    if (series->precise)
+    {
+        if (series->precise_capacity > 0)
+        {
+            FillPreciseColor(*series);
+        }
+        return;
+    }
+
+    if (m_per_series_colors)
+    {
+        if (!m_series_draws_dirty && series->draw_index != NO_DRAW_COMMAND)
+        {
+            const gplot::core::Color packed { VecToInt32(color) };
+            m_series_buffer.Update(1, sizeof(packed), &packed, sizeof(packed) * series->draw_index);
+        }
+        return;
+    }
 
-    auto frag_code = disk_io.Read("../resources/grid.frag.glsl");
-    auto vert_code = disk_io.Read("../resources/grid.vert.glsl");
+    // A dirty layout is repacked on the next Render, which picks up the new color anyway. The whole region is
+    // colored since min/max views are rewritten in place without touching the colors.
+    if (m_series_layout_dirty || series->capacity == 0)
+    {
+        return;
+    }
 
-    return {"line", vert_code.data(), frag_code.data()};
+    const std::vector<gplot::core::Color> packed(series->capacity, gplot::core::Color { VecToInt32(color) });
+    m_series_buffer.Update(1, sizeof(gplot::core::Color) * packed.size(), packed.data(), sizeof(gplot::core::Color) * series->first);
 }
 
-gplot::graphics::Shader Plotter::LoadLineShader()
+void Plotter::RemoveSeries(SeriesHandle handle)
 {
-    gplot::core::DriveIO disk_io;
+    auto* series = FindSeries(handle);
+    if (!series)
+    {
+        return;
+    }
 
-    auto frag_code = disk_io.Read("../resources/line.frag.glsl");
-    auto vert_code = disk_io.Read("../resources/line.vert.glsl");
-    auto geom_code = disk_io.Read("../resources/line.geom.glsl");
+    m_series_layout_dirty |= IsPacked(*series);
 
-    return {"line", vert_code.data(), frag_code.data(), geom_code.data()};
+    *series = { };
+    m_free_series.push_back(static_cast<std::uint32_t>(handle) - 1);
 }
 
-gplot::graphics::VertexBuffer Plotter::CreateVertexBuffer()
+SeriesHandle Plotter::AddStreamingSeries(size_t capacity, glm::vec4 color)
 {
-    gplot::graphics::VertexBuffer::GeometryBufferDescriptor vb_descriptor;
+    if (capacity == 0)
+    {
+        return SeriesHandle::eInvalid;
+    }
 
-    vb_descriptor.attributes.resize(1);
-    vb_descriptor.attributes[0].is_data_normalized = false;
-    vb_descriptor.attributes[0].data_count = 2;
-    vb_descriptor.attributes[0].data = gplot::graphics::VertexBuffer::DataType_t::eFloat32;
+    const auto handle = AllocateSeries();
 
-    gplot::graphics::VertexBuffer::GeometryBufferDescriptor col_descriptor;
-    col_descriptor.attributes.resize(1);
-    col_descriptor.attributes[0].data_count = 1;
-    col_descriptor.attributes[0].data = gplot::graphics::VertexBuffer::DataType_t::eUInt32;
+    auto& series = *FindSeries(handle);
+    series.color = color;
+    series.vertices.resize(capacity);
+    series.ring_capacity = capacity;
+    series.ring = std::make_unique<gplot::graphics::VertexBuffer>(CreateVertexBufferDescriptor());
 
-    gplot::graphics::VertexBuffer::VertexBufferDescriptor vao_descriptor;
-    vao_descriptor.geometry_buffers.push_back(vb_descriptor);
-    vao_descriptor.geometry_buffers.push_back(col_descriptor);
+    series.ring->Resize(0, sizeof(gplot::core::Vertex) * (capacity + RING_PADDING));
+    series.ring->Resize(1, sizeof(gplot::core::Color) * (capacity + RING_PADDING));
+    FillRingColor(series);
 
-    return gplot::graphics::VertexBuffer(vao_descriptor);
+    return handle;
 }
 
-void Plotter::PlotLinesInternal(const std::vector<std::vector<gplot::core::Vertex>>& lines, const std::vector<glm::vec4>& colors, const gplot::graphics::VertexBuffer& buffer) const
+void Plotter::AppendSeries(SeriesHandle handle, std::span<const gplot::core::Vertex> vertices)
 {
-    std::vector<GLint> firsts;
-    std::vector<GLsizei> sizes;
+    auto* series = FindSeries(handle);
+    if (!series || vertices.empty())
+    {
+        return;
+    }
 
-    size_t total_size = 0;
-    for (const auto& line : lines)
+    if (series->ring)
     {
-        if (line.empty())
-        {
-            continue;
-        }
+        WriteRing(*series, vertices);
+        return;
+    }
 
-        firsts.push_back(total_size);
-        sizes.push_back(line.size());
+    if (series->mapped)
+    {
+        series->vertices.insert(series->vertices.end(), vertices.begin(), vertices.end());
+        series->mapped_dirty = true;
+        return;
+    }
 
-        total_size += line.size();
+    if (series->precise)
+    {
+        std::vector<glm::dvec2> points(vertices.size());
+        std::transform(vertices.begin(), vertices.end(), points.begin(), [](const gplot::core::Vertex& vertex) { return glm::dvec2(vertex.pos); });
+        AppendPreciseSeries(handle, points);
+        return;
     }
 
-    if (!total_size)
+    const size_t previous_size = series->vertices.size();
+    series->vertices.insert(series->vertices.end(), vertices.begin(), vertices.end());
+    series->view_dirty = true;
+
+    if (series->decimation == Decimation::eMinMax)
+    {
+        series->pyramid.Extend(series->vertices, previous_size);
+    }
+
+    m_series_layout_dirty = true;
+}
+
+SeriesHandle Plotter::AddColormappedSeries(std::vector<gplot::core::Vertex> vertices, std::vector<float> values, Colormap colormap, glm::vec2 value_range)
+{
+    const auto handle = AllocateSeries();
+
+    auto& series = *FindSeries(handle);
+    series.vertices = std::move(vertices);
+    series.values = std::move(values);
+    series.colormap = colormap;
+    series.value_range = value_range;
+    series.mapped = std::make_unique<gplot::graphics::VertexBuffer>(CreateColormapBufferDescriptor());
+    series.mapped_dirty = true;
+
+    return handle;
+}
+
+void Plotter::UpdateSeriesValues(SeriesHandle handle, std::vector<float> values)
+{
+    auto* series = FindSeries(handle);
+    if (!series || !series->mapped)
     {
         return;
     }
 
-    buffer.Bind();
-    buffer.Resize(1, sizeof(gplot::core::Color) * total_size);
-    buffer.Resize(0, sizeof(gplot::core::Vertex) * total_size);
+    // Same-sized updates only rewrite the value buffer
+    if (!series->mapped_dirty && values.size() == series->values.size() && series->count == values.size() && !values.empty())
+    {
+        series->mapped->Update(1, sizeof(float) * values.size(), values.data());
+        series->values = std::move(values);
+        return;
+    }
 
-    auto* colors_ptr = buffer.MapBuffer<gplot::core::Color>(1, 0, total_size, GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT);
-    auto* vertex_ptr = buffer.MapBuffer<gplot::core::Vertex>(0, 0, total_size, GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT);
+    series->values = std::move(values);
+    series->mapped_dirty = true;
+}
 
-    for (int i = 0; i < firsts.size(); i++)
+void Plotter::SetSeriesColormap(SeriesHandle handle, Colormap colormap)
+{
+    if (auto* series = FindSeries(handle))
     {
-        std::copy(lines[i].begin(), lines[i].end(), vertex_ptr);
-        std::fill(colors_ptr, colors_ptr + lines[i].size(), gplot::core::Color {VecToInt32(colors[i]) });
+        series->colormap = colormap;
+    }
+}
 
-        colors_ptr += lines[i].size();
-        vertex_ptr += lines[i].size();
+void Plotter::SetSeriesValueRange(SeriesHandle handle, glm::vec2 value_range)
+{
+    if (auto* series = FindSeries(handle))
+    {
+        series->value_range = value_range;
     }
+}
 
-    buffer.UnmapBuffer(0);
-    buffer.UnmapBuffer(1);
+SeriesHandle Plotter::AddPreciseSeries(std::vector<glm::dvec2> points, glm::vec4 color)
+{
+    const auto handle = AllocateSeries();
+
+    auto& series = *FindSeries(handle);
+    series.color = color;
+    series.points = std::move(points);
+    series.precise = std::make_unique<gplot::graphics::VertexBuffer>(m_chunk_encoding == ChunkEncoding::eUNorm16 ? CreateQuantizedBufferDescriptor() : CreateVertexBufferDescriptor());
+
+    return handle;
+}
+
+void Plotter::UpdatePreciseSeries(SeriesHandle handle, std::vector<glm::dvec2> points)
+{
+    auto* series = FindSeries(handle);
+    if (!series || !series->precise)
+    {
+        return;
+    }
+
+    series->points = std::move(points);
+    series->precise_valid = 0;
+}
+
+void Plotter::AppendPreciseSeries(SeriesHandle handle, std::span<const glm::dvec2> points)
+{
+    auto* series = FindSeries(handle);
+    if (!series || !series->precise || points.empty())
+    {
+        return;
+    }
+
+    // Chunk i reads up to point (i + 1) * PRECISE_CHUNK + 2, the ones ending before the old size are unchanged
+    const size_t previous_size = series->points.size();
+    series->points.insert(series->points.end(), points.begin(), points.end());
+    series->precise_valid = std::min(series->precise_valid, previous_size >= 2 ? (previous_size - 2) / PRECISE_CHUNK : 0);
+}
+
+void Plotter::TrimSeries(SeriesHandle handle, size_t count)
+{
+    auto* series = FindSeries(handle);
+    if (!series || count == 0)
+    {
+        return;
+    }
+
+    if (series->ring)
+    {
+        count = std::min(count, series->ring_size);
+        series->ring_head = (series->ring_head + count) % series->ring_capacity;
+        series->ring_size -= count;
+        return;
+    }
+
+    if (series->precise)
+    {
+        count = std::min(count, series->points.size());
+        series->points.erase(series->points.begin(), series->points.begin() + static_cast<std::ptrdiff_t>(count));
+        series->precise_valid = 0;
+        return;
+    }
+
+    count = std::min(count, series->vertices.size());
+    series->vertices.erase(series->vertices.begin(), series->vertices.begin() + static_cast<std::ptrdiff_t>(count));
+
+    // Values stay aligned with their vertices
+    if (series->mapped)
+    {
+        series->values.erase(series->values.begin(), series->values.begin() + static_cast<std::ptrdiff_t>(std::min(count, series->values.size())));
+        series->mapped_dirty = true;
+        return;
+    }
+    series->view_dirty = true;
+
+    // Trimming shifts every sample index, so the summaries cannot be patched
+    if (series->decimation == Decimation::eMinMax)
+    {
+        series->pyramid.Build(series->vertices);
+    }
+
+    m_series_layout_dirty = true;
+}
+
+void Plotter::SetSeriesDecimation(SeriesHandle handle, Decimation decimation, size_t target_points)
+{
+    auto* series = FindSeries(handle);
+    if (!series || series->ring || series->mapped || series->precise || (series->decimation == decimation && series->decimation_target == target_points))
+    {
+        return;
+    }
+
+    series->decimation = decimation;
+    series->decimation_target = target_points;
+    series->decimated = { };
+    series->view_dirty = true;
+
+    if (decimation == Decimation::eMinMax)
+    {
+        series->pyramid.Build(series->vertices);
+    }
+    else
+    {
+        series->pyramid.Clear();
+    }
+    m_series_layout_dirty = true;
+}
+
+void Plotter::SetCanvasSize(int width, int height)
+{
+    m_canvas_size = { width, height };
+}
+
+void Plotter::SetSeriesSortedX(SeriesHandle handle, bool sorted_x)
+{
+    if (auto* series = FindSeries(handle))
+    {
+        series->sorted_x = sorted_x;
+        m_series_draws_dirty = true;
+    }
+}
+
+void Plotter::SetSeriesVisible(SeriesHandle handle, bool visible)
+{
+    auto* series = FindSeries(handle);
+    if (!series || series->visible == visible)
+    {
+        return;
+    }
+
+    series->visible = visible;
+    if (!IsPacked(*series) || m_series_draws_dirty || series->draw_index == NO_DRAW_COMMAND)
+    {
+        return;
+    }
+
+    auto& command = m_draw_commands[series->draw_index];
+    command.instance_count = visible ? series->draw_instances : 0;
+    m_series_draws.SetInstanceCount(series->draw_index, command.instance_count);
+}
 
-    glMultiDrawArrays(GL_LINE_STRIP_ADJACENCY, firsts.data(), sizes.data(), lines.size());
-    gplot::graphics::VertexBuffer::Unbind();
+void Plotter::Render(core::RectF bounds, CameraViewport camera, float line_thickness, float line_feather)
+{
+    m_renderer.PrepareFrame();
+    Record(m_renderer, bounds, camera, line_thickness, line_feather);
+    m_renderer.RenderCurrent();
+}
+
+void Plotter::Record(gplot::graphics::Renderer& renderer, core::RectF bounds, CameraViewport camera, float line_thickness, float line_feather)
+{
+    const FrameUniforms::Block frame { MakeViewMatrix(camera), line_thickness, line_feather };
+    renderer.SetUniformBlock(FrameUniforms::BINDING, &frame, sizeof(frame));
+
+    UpdateGrid(bounds, 10, 10);
+    renderer.SetState({ &m_grid_shader, gplot::graphics::RenderLayer::eGrid });
+    renderer.RenderMultiBuffer(gplot::graphics::Primitive::eLinesStripAdjacent, m_grid_buffer, m_grid_firsts, m_grid_sizes);
+
+    const glm::vec2 range = GetViewRange(camera);
+
+    UpdateSeriesViews(camera);
+    UploadSeries();
+
+    // Every series buffer has its size for this frame here, before the first line state is recorded
+    ReserveSeriesTexels();
+
+    if (m_indirect_draws)
+    {
+        UpdateSeriesDraws(range);
+
+        auto state = MakeLineState(GetSeriesShader(), m_series_buffer, m_color_texture, GL_R32UI);
+        if (m_per_series_colors)
+        {
+            state.texel_buffers[1] = { };
+        }
+
+        renderer.SetState(state);
+        renderer.RenderMultiIndirect(m_line_pipeline == LinePipeline::eInstanced ? gplot::graphics::Primitive::eTriangleStrip : gplot::graphics::Primitive::eLinesStripAdjacent, m_series_buffer, m_series_draws);
+    }
+    else
+    {
+        BuildSeriesDraws(range);
+        RecordLineRanges(renderer, MakeLineState(*m_shader, m_series_buffer, m_color_texture, GL_R32UI), m_series_buffer, m_series_firsts, m_series_sizes);
+    }
+
+    for (auto& series : m_series)
+    {
+        if (!series.alive || !series.visible)
+        {
+            continue;
+        }
+
+        if (series.ring)
+        {
+            RecordRing(renderer, series, range);
+        }
+        else if (series.mapped)
+        {
+            RecordColormapped(renderer, series, range);
+        }
+        else if (series.precise)
+        {
+            RecordPrecise(renderer, series, camera, frame);
+        }
+    }
+}
+
+LinePipeline Plotter::GetLinePipeline() const noexcept
+{
+    return m_line_pipeline;
+}
+
+void Plotter::RenderGrid(core::RectF bounds, int count_x, int count_y)
+{
+    UpdateGrid(bounds, count_x, count_y);
+    DrawLines(m_grid_buffer, m_grid_firsts, m_grid_sizes);
+}
+
+void Plotter::UpdateGrid(core::RectF bounds, int count_x, int count_y)
+{
+    if (bounds == m_grid_bounds && !m_grid_firsts.empty())
+    {
+        return;
+    }
+
+    std::vector<std::vector<gplot::core::Vertex>> lines;
+    lines.reserve(count_x + count_y);
+
+    auto step_x = glm::abs(bounds.min.x - bounds.max.x) / static_cast<float>(count_x);
+    auto step_y = glm::abs(bounds.min.y - bounds.max.y) / static_cast<float>(count_y);
+
+    std::vector<gplot::core::Vertex> curr;
+    for (int i = 0; i < count_x + 1; i++)
+    {
+        curr.resize(4);
+        curr[0] = { glm::vec2(bounds.min.x + step_x * static_cast<float>(i), bounds.min.y) };
+        curr[1] = { glm::vec2(bounds.min.x + step_x * static_cast<float>(i), bounds.min.y) };
+        curr[2] = { glm::vec2(bounds.min.x + step_x * static_cast<float>(i), bounds.max.y) };
+        curr[3] = { glm::vec2(bounds.min.x + step_x * static_cast<float>(i), bounds.max.y) };
+        lines.push_back(curr);
+    }
+
+    for (int i = 0; i < count_y + 1; i++)
+    {
+        curr.resize(4);
+        curr[0] = { glm::vec2(bounds.min.x, bounds.min.y + step_y * static_cast<float>(i)) };
+        curr[1] = { glm::vec2(bounds.min.x, bounds.min.y + step_y * static_cast<float>(i)) };
+        curr[2] = { glm::vec2(bounds.max.x, bounds.min.y + step_y * static_cast<float>(i)) };
+        curr[3] = { glm::vec2(bounds.max.x, bounds.min.y + step_y * static_cast<float>(i)) };
+        lines.push_back(curr);
+    }
+
+    glm::vec4 color = { 0.3F, 0.3F, 0.3F, 1.0F };
+    UploadLines(lines, std::vector<glm::vec4>(lines.size(), color), m_grid_buffer, m_grid_firsts, m_grid_sizes);
+    m_grid_bounds = bounds;
+}
+
+gplot::graphics::Shader Plotter::LoadGridShader()
+{
+    const auto frag_code = gplot::graphics::GetShaderSource("grid.frag.glsl");
+    const auto vert_code = gplot::graphics::GetShaderSource("grid.vert.glsl");
+
+    return {"grid", vert_code.c_str(), frag_code.c_str()};
+}
+
+std::unique_ptr<gplot::graphics::Shader> Plotter::LoadLineShader(LinePipeline pipeline)
+{
+    if (pipeline == LinePipeline::eInstanced)
+    {
+        const auto frag_code = gplot::graphics::GetShaderSource("line.frag.glsl");
+        const auto vert_code = gplot::graphics::GetShaderSource("line_instanced.vert.glsl");
+
+        return std::make_unique<gplot::graphics::Shader>("line", vert_code.c_str(), frag_code.c_str());
+    }
+
+    const auto frag_code = gplot::graphics::GetShaderSource("line.frag.glsl");
+    const auto vert_code = gplot::graphics::GetShaderSource("line.vert.glsl");
+    const auto geom_code = gplot::graphics::GetShaderSource("line.geom.glsl");
+
+    return std::make_unique<gplot::graphics::Shader>("line", vert_code.c_str(), frag_code.c_str(), geom_code.c_str());
+}
+
+std::unique_ptr<gplot::graphics::Shader> Plotter::LoadSeriesShader(LinePipeline pipeline, bool per_series_colors)
+{
+    if (pipeline != LinePipeline::eInstanced || !per_series_colors)
+    {
+        return nullptr;
+    }
+
+    const auto frag_code = gplot::graphics::GetShaderSource("line.frag.glsl");
+    const auto vert_code = gplot::graphics::AddShaderDefine(gplot::graphics::GetShaderSource("line_instanced.vert.glsl"), "PER_SERIES_COLOR");
+
+    return std::make_unique<gplot::graphics::Shader>("line_series", vert_code.c_str(), frag_code.c_str());
+}
+
+bool Plotter::ResolvePerSeriesColors(const PlotterDescriptor& descriptor)
+{
+    // The table is indexed by the base instance of the indirect commands
+    return descriptor.series_colors == SeriesColors::ePerSeries
+        && descriptor.indirect_draws
+        && gplot::graphics::IndirectBuffer::IsSupported();
+}
+
+const gplot::graphics::Shader& Plotter::GetSeriesShader() const noexcept
+{
+    return m_series_shader ? *m_series_shader : *m_shader;
+}
+
+const gplot::graphics::Shader& Plotter::GetColormapShader()
+{
+    if (m_colormap_shader)
+    {
+        return *m_colormap_shader;
+    }
+
+    const auto frag_code = gplot::graphics::GetShaderSource("line.frag.glsl");
+    if (m_line_pipeline == LinePipeline::eInstanced)
+    {
+        const auto vert_code = gplot::graphics::AddShaderDefine(gplot::graphics::GetShaderSource("line_instanced.vert.glsl"), "COLORMAP");
+        m_colormap_shader = std::make_unique<gplot::graphics::Shader>("line_colormap", vert_code.c_str(), frag_code.c_str());
+    }
+    else
+    {
+        const auto vert_code = gplot::graphics::AddShaderDefine(gplot::graphics::GetShaderSource("line.vert.glsl"), "COLORMAP");
+        const auto geom_code = gplot::graphics::GetShaderSource("line.geom.glsl");
+        m_colormap_shader = std::make_unique<gplot::graphics::Shader>("line_colormap", vert_code.c_str(), frag_code.c_str(), geom_code.c_str());
+    }
+
+    m_colormap_shader->BindUniformBlock("FrameData", FrameUniforms::BINDING);
+    m_colormap_shader->BindUniformBlock("SeriesData", SERIES_DATA_BINDING);
+
+    m_colormap_shader->Use();
+    m_colormap_shader->Set("uColormap", static_cast<int>(COLORMAP_UNIT));
+    if (m_line_pipeline == LinePipeline::eInstanced)
+    {
+        m_colormap_shader->Set("uPositions", 0);
+        m_colormap_shader->Set("uValues", 1);
+    }
+
+    return *m_colormap_shader;
+}
+
+GLuint Plotter::GetColormapTexture(Colormap colormap)
+{
+    auto& texture = m_colormaps[static_cast<size_t>(colormap)];
+    if (!texture)
+    {
+        texture = std::make_unique<ColormapTexture>(colormap);
+    }
+
+    return texture->GetTextureId();
+}
+
+LinePipeline Plotter::ResolveLinePipeline(LinePipeline pipeline)
+{
+    if (pipeline != LinePipeline::eAuto)
+    {
+        return pipeline;
+    }
+
+    return gplot::graphics::BufferTexture::GetMaxTexels() >= MIN_INSTANCED_TEXELS ? LinePipeline::eInstanced : LinePipeline::eGeometryShader;
+}
+
+void Plotter::ReserveTexels(size_t texels)
+{
+    if (m_line_pipeline != LinePipeline::eInstanced || texels <= m_max_texels)
+    {
+        return;
+    }
+
+    std::cerr << __FILE__ << ":" << __LINE__ << " " << texels << " vertices exceed the buffer texture limit of " << m_max_texels << ", falling back to the geometry shader pipeline" << std::endl;
+
+    m_line_pipeline = LinePipeline::eGeometryShader;
+    m_shader = LoadLineShader(m_line_pipeline);
+    m_shader->BindUniformBlock("FrameData", FrameUniforms::BINDING);
+
+    // Both are made for the instanced pipeline, the colormap shader is created again on its next use
+    m_series_shader.reset();
+    m_colormap_shader.reset();
+
+    // The indirect commands hold instanced quads
+    m_series_draws_dirty = true;
+}
+
+void Plotter::ReserveSeriesTexels()
+{
+    size_t texels = m_series_capacity;
+    for (const auto& series : m_series)
+    {
+        if (!series.alive)
+        {
+            continue;
+        }
+
+        if (series.ring)
+        {
+            texels = std::max(texels, series.ring_capacity + RING_PADDING);
+        }
+        else if (series.mapped)
+        {
+            texels = std::max(texels, std::min(series.vertices.size(), series.values.size()));
+        }
+        else if (series.precise)
+        {
+            // The detail store never holds more slots in use than there are chunks
+            texels = std::max(texels, PRECISE_SLOT * ((series.points.size() + PRECISE_CHUNK - 1) / PRECISE_CHUNK));
+        }
+    }
+
+    ReserveTexels(texels);
+}
+
+gplot::graphics::VertexBuffer Plotter::CreateVertexBuffer(bool per_series_colors)
+{
+    return gplot::graphics::VertexBuffer(CreateVertexBufferDescriptor(per_series_colors));
+}
+
+gplot::graphics::VertexBuffer::VertexBufferDescriptor Plotter::CreateVertexBufferDescriptor(bool per_series_colors)
+{
+    gplot::graphics::VertexBuffer::GeometryBufferDescriptor vb_descriptor;
+
+    vb_descriptor.attributes.resize(1);
+    vb_descriptor.attributes[0].is_data_normalized = false;
+    vb_descriptor.attributes[0].data_count = 2;
+    vb_descriptor.attributes[0].data = gplot::graphics::VertexBuffer::DataType_t::eFloat32;
+
+    gplot::graphics::VertexBuffer::GeometryBufferDescriptor col_descriptor;
+    col_descriptor.attributes.resize(1);
+    col_descriptor.attributes[0].data_count = 1;
+    col_descriptor.attributes[0].data = gplot::graphics::VertexBuffer::DataType_t::eUInt32;
+    col_descriptor.divisor = per_series_colors ? PER_SERIES_DIVISOR : 0;
+
+    gplot::graphics::VertexBuffer::VertexBufferDescriptor vao_descriptor;
+    vao_descriptor.geometry_buffers.push_back(vb_descriptor);
+    vao_descriptor.geometry_buffers.push_back(col_descriptor);
+
+    return vao_descriptor;
+}
+
+gplot::graphics::VertexBuffer::VertexBufferDescriptor Plotter::CreateColormapBufferDescriptor()
+{
+    gplot::graphics::VertexBuffer::GeometryBufferDescriptor vb_descriptor;
+    vb_descriptor.attributes.resize(1);
+    vb_descriptor.attributes[0].data_count = 2;
+    vb_descriptor.attributes[0].data = gplot::graphics::VertexBuffer::DataType_t::eFloat32;
+
+    gplot::graphics::VertexBuffer::GeometryBufferDescriptor value_descriptor;
+    value_descriptor.attributes.resize(1);
+    value_descriptor.attributes[0].data_count = 1;
+    value_descriptor.attributes[0].data = gplot::graphics::VertexBuffer::DataType_t::eFloat32;
+
+    gplot::graphics::VertexBuffer::VertexBufferDescriptor vao_descriptor;
+    vao_descriptor.geometry_buffers.push_back(vb_descriptor);
+    vao_descriptor.geometry_buffers.push_back(value_descriptor);
+
+    return vao_descriptor;
+}
+
+gplot::graphics::VertexBuffer::VertexBufferDescriptor Plotter::CreateQuantizedBufferDescriptor()
+{
+    auto vao_descriptor = CreateVertexBufferDescriptor();
+
+    auto& position = vao_descriptor.geometry_buffers[0].attributes[0];
+    position.data = gplot::graphics::VertexBuffer::DataType_t::eUInt16;
+    position.is_data_normalized = true;
+
+    return vao_descriptor;
+}
+
+void Plotter::PlotLinesInternal(const std::vector<std::vector<gplot::core::Vertex>>& lines, const std::vector<glm::vec4>& colors, const gplot::graphics::VertexBuffer& buffer)
+{
+    UploadLines(lines, colors, buffer, m_buffer_firsts, m_buffer_sizes);
+    if (!m_buffer_firsts.empty())
+    {
+        ReserveTexels(static_cast<size_t>(m_buffer_firsts.back()) + static_cast<size_t>(m_buffer_sizes.back()));
+    }
+
+    DrawLineRanges(buffer, m_buffer_firsts.data(), m_buffer_sizes.data(), static_cast<GLsizei>(m_buffer_firsts.size()));
+}
+
+void Plotter::PlotLinesPersistent(const std::vector<std::vector<gplot::core::Vertex>>& lines, const std::vector<glm::vec4>& colors)
+{
+    m_buffer_firsts.clear();
+    m_buffer_sizes.clear();
+
+    size_t total_size = 0;
+    for (const auto& line : lines)
+    {
+        if (line.empty())
+        {
+            continue;
+        }
+
+        m_buffer_firsts.push_back(static_cast<GLint>(total_size));
+        m_buffer_sizes.push_back(static_cast<GLsizei>(line.size()));
+
+        total_size += line.size();
+    }
+
+    if (!total_size)
+    {
+        return;
+    }
+
+    if (total_size > m_buffer.GetPersistentRegionCapacity())
+    {
+        const auto capacity = m_buffer.GetPersistentRegionCapacity();
+        m_buffer.CreatePersistentStorage(std::max(total_size, capacity + capacity / 2), m_descriptor.persistent_regions);
+    }
+
+    // Every region is addressed through the same buffer texture
+    ReserveTexels(m_buffer.GetPersistentRegionCapacity() * m_descriptor.persistent_regions);
+
+    const auto base = m_buffer.BeginPersistentRegion();
+    auto* colors_ptr = m_buffer.GetPersistentRegion<gplot::core::Color>(1);
+    auto* vertex_ptr = m_buffer.GetPersistentRegion<gplot::core::Vertex>(0);
+
+    for (size_t i = 0; i < lines.size(); i++)
+    {
+        if (lines[i].empty())
+        {
+            continue;
+        }
+
+        std::copy(lines[i].begin(), lines[i].end(), vertex_ptr);
+        std::fill(colors_ptr, colors_ptr + lines[i].size(), gplot::core::Color { VecToInt32(colors[i]) });
+
+        colors_ptr += lines[i].size();
+        vertex_ptr += lines[i].size();
+    }
+
+    for (auto& first : m_buffer_firsts)
+    {
+        first += static_cast<GLint>(base);
+    }
+
+    DrawLineRanges(m_buffer, m_buffer_firsts.data(), m_buffer_sizes.data(), static_cast<GLsizei>(m_buffer_firsts.size()));
+    m_buffer.EndPersistentRegion();
+}
+
+void Plotter::UploadLines(const std::vector<std::vector<gplot::core::Vertex>>& lines, const std::vector<glm::vec4>& colors, const gplot::graphics::VertexBuffer& buffer, std::vector<GLint>& firsts, std::vector<GLsizei>& sizes)
+{
+    firsts.clear();
+    sizes.clear();
+
+    size_t total_size = 0;
+    for (const auto& line : lines)
+    {
+        if (line.empty())
+        {
+            continue;
+        }
+
+        firsts.push_back(total_size);
+        sizes.push_back(line.size());
+
+        total_size += line.size();
+    }
+
+    if (!total_size)
+    {
+        return;
+    }
+
+    buffer.Resize(1, sizeof(gplot::core::Color) * total_size);
+    buffer.Resize(0, sizeof(gplot::core::Vertex) * total_size);
+
+    auto* colors_ptr = buffer.MapBuffer<gplot::core::Color>(1, 0, total_size, GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT);
+    auto* vertex_ptr = buffer.MapBuffer<gplot::core::Vertex>(0, 0, total_size, GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT);
+
+    for (size_t i = 0; i < lines.size(); i++)
+    {
+        if (lines[i].empty())
+        {
+            continue;
+        }
+
+        std::copy(lines[i].begin(), lines[i].end(), vertex_ptr);
+        std::fill(colors_ptr, colors_ptr + lines[i].size(), gplot::core::Color {VecToInt32(colors[i]) });
+
+        colors_ptr += lines[i].size();
+        vertex_ptr += lines[i].size();
+    }
+
+    buffer.UnmapBuffer(0);
+    buffer.UnmapBuffer(1);
+}
+
+void Plotter::DrawLines(const gplot::graphics::VertexBuffer& buffer, const std::vector<GLint>& firsts, const std::vector<GLsizei>& sizes)
+{
+    if (firsts.empty())
+    {
+        return;
+    }
+
+    buffer.Bind();
+    glMultiDrawArrays(GL_LINE_STRIP_ADJACENCY, firsts.data(), sizes.data(), static_cast<GLsizei>(firsts.size()));
+}
+
+void Plotter::DrawLineRanges(const gplot::graphics::VertexBuffer& buffer, const GLint* firsts, const GLsizei* sizes, GLsizei count)
+{
+    if (count == 0)
+    {
+        return;
+    }
+
+    m_shader->Use();
+    if (m_line_pipeline == LinePipeline::eGeometryShader)
+    {
+        buffer.Bind();
+        glMultiDrawArrays(GL_LINE_STRIP_ADJACENCY, firsts, sizes, count);
+        return;
+    }
+
+    buffer.BindInstanceAttributes();
+
+    m_position_texture.Attach(buffer.GetBufferId(0), GL_RG32F);
+    m_color_texture.Attach(buffer.GetBufferId(1), GL_R32UI);
+    m_position_texture.Bind(0);
+    m_color_texture.Bind(1);
+
+    // A strip of n vertices holds n - 3 adjacency primitives, each one becomes an instance drawing its p1 -> p2 segment
+    for (GLsizei i = 0; i < count; i++)
+    {
+        if (sizes[i] < 4)
+        {
+            continue;
+        }
+
+        const auto command = MakeDrawCommand(firsts[i], sizes[i]);
+        glDrawArraysInstanced(GL_TRIANGLE_STRIP, static_cast<GLint>(command.first), static_cast<GLsizei>(command.count), static_cast<GLsizei>(command.instance_count));
+    }
+}
+
+void Plotter::RecordLineRanges(gplot::graphics::Renderer& renderer, const gplot::graphics::Renderer::RenderState& state, const gplot::graphics::VertexBuffer& buffer, std::span<const GLint> firsts, std::span<const GLsizei> sizes)
+{
+    renderer.SetState(state);
+    if (m_line_pipeline == LinePipeline::eGeometryShader)
+    {
+        renderer.RenderMultiBuffer(gplot::graphics::Primitive::eLinesStripAdjacent, buffer, firsts, sizes);
+        return;
+    }
+
+    m_record_firsts.clear();
+    m_record_sizes.clear();
+    for (size_t i = 0; i < firsts.size(); i++)
+    {
+        if (sizes[i] >= 4)
+        {
+            const auto command = MakeDrawCommand(firsts[i], sizes[i]);
+            m_record_firsts.push_back(static_cast<GLint>(command.first));
+            m_record_sizes.push_back(static_cast<GLsizei>(command.instance_count));
+        }
+    }
+
+    renderer.RenderInstancedRanges(gplot::graphics::Primitive::eTriangleStrip, buffer, 4, m_record_firsts, m_record_sizes);
+}
+
+gplot::graphics::Renderer::RenderState Plotter::MakeLineState(const gplot::graphics::Shader& shader, const gplot::graphics::VertexBuffer& buffer, const gplot::graphics::BufferTexture& attribute_texture, GLenum attribute_format, GLenum position_format) const
+{
+    gplot::graphics::Renderer::RenderState state { &shader, gplot::graphics::RenderLayer::eSeries };
+    if (m_line_pipeline == LinePipeline::eInstanced)
+    {
+        state.texel_buffers[0] = { &m_position_texture, buffer.GetBufferId(0), position_format, 0 };
+        state.texel_buffers[1] = { &attribute_texture, buffer.GetBufferId(1), attribute_format, 1 };
+        state.vertex_pulling = true;
+    }
+
+    return state;
+}
+
+gplot::graphics::IndirectBuffer::DrawArraysCommand Plotter::MakeDrawCommand(size_t first, size_t size) const
+{
+    if (m_line_pipeline == LinePipeline::eGeometryShader)
+    {
+        return { static_cast<GLuint>(size), 1, static_cast<GLuint>(first), 0 };
+    }
+
+    // Quads start at vertex 4 * segment start, see line_instanced.vert.glsl
+    if (size < 4)
+    {
+        return { 4, 0, 0, 0 };
+    }
+
+    return { 4, static_cast<GLuint>(size - 3), static_cast<GLuint>(4 * (first + 1)), 0 };
+}
+
+SeriesHandle Plotter::AllocateSeries()
+{
+    std::uint32_t index;
+    if (m_free_series.empty())
+    {
+        index = static_cast<std::uint32_t>(m_series.size());
+        m_series.emplace_back();
+    }
+    else
+    {
+        index = m_free_series.back();
+        m_free_series.pop_back();
+    }
+
+    m_series[index].alive = true;
+    return static_cast<SeriesHandle>(index + 1);
+}
+
+Plotter::LineSeries* Plotter::FindSeries(SeriesHandle handle)
+{
+    const auto index = static_cast<std::uint32_t>(handle);
+    if (index == 0 || index > m_series.size() || !m_series[index - 1].alive)
+    {
+        return nullptr;
+    }
+
+    return &m_series[index - 1];
+}
+
+bool Plotter::IsPacked(const LineSeries& series)
+{
+    return !series.ring && !series.mapped && !series.precise;
+}
+
+void Plotter::UpdateSeriesViews(const CameraViewport& camera)
+{
+    const glm::vec2 range = GetViewRange(camera);
+    const bool view_changed = range != m_view_range || m_canvas_size.x != m_view_columns;
+
+    m_view_range = range;
+    m_view_columns = m_canvas_size.x;
+
+    std::vector<LineSeries*> lttb_pending;
+    for (auto& series : m_series)
+    {
+        if (!series.alive || !IsPacked(series))
+        {
+            continue;
+        }
+
+        if (series.decimation == Decimation::eNone)
+        {
+            series.view_dirty = false;
+            continue;
+        }
+
+        // LTTB views do not depend on the camera and are reduced in parallel below
+        if (series.decimation == Decimation::eLTTB)
+        {
+            if (series.view_dirty)
+            {
+                lttb_pending.push_back(&series);
+            }
+            continue;
+        }
+
+        if (!view_changed && !series.view_dirty)
+        {
+            continue;
+        }
+
+        // The pyramid narrows the input down to the visible buckets of a level about a pixel wide
+        series.pyramid.Collect(series.vertices, range.x, range.y, m_view_columns, m_view_scratch);
+        DecimateMinMax(m_view_scratch, range.x, range.y, m_view_columns, series.decimated);
+
+        series.view_dirty = false;
+        if (m_series_layout_dirty || series.decimated.size() > series.capacity)
+        {
+            m_series_layout_dirty = true;
+            continue;
+        }
+
+        // The view still fits the region of the series, the rest of the packed store is left alone
+        if (!series.decimated.empty())
+        {
+            m_series_buffer.Update(0, sizeof(gplot::core::Vertex) * series.decimated.size(), series.decimated.data(), sizeof(gplot::core::Vertex) * series.first);
+        }
+        series.count = series.decimated.size();
+        m_series_draws_dirty = true;
+    }
+
+    if (lttb_pending.empty())
+    {
+        return;
+    }
+
+    gplot::core::ThreadPool::GetDefault().ParallelFor(lttb_pending.size(), 1, [&](size_t begin, size_t end)
+    {
+        for (size_t i = begin; i < end; i++)
+        {
+            auto& series = *lttb_pending[i];
+            DecimateLTTB(series.vertices, series.decimation_target, series.decimated);
+            series.view_dirty = false;
+        }
+    });
+
+    m_series_layout_dirty = true;
+}
+
+void Plotter::UploadSeries()
+{
+    if (!m_series_layout_dirty)
+    {
+        return;
+    }
+
+    size_t total_size = 0;
+    for (auto& series : m_series)
+    {
+        // Colormapped series keep the count of their own buffer
+        if (series.mapped)
+        {
+            continue;
+        }
+
+        const auto& drawn = GetDrawnVertices(series);
+
+        series.count = 0;
+        series.capacity = 0;
+        if (!series.alive || !IsPacked(series))
+        {
+            continue;
+        }
+
+        // Room for the largest view DecimateMinMax makes at the current width
+        series.capacity = drawn.size();
+        if (series.decimation == Decimation::eMinMax)
+        {
+            series.capacity = std::max(series.capacity, std::min(series.vertices.size(), static_cast<size_t>(std::max(m_view_columns, 0) + 2) * 4));
+        }
+
+        series.first = total_size;
+        series.count = drawn.size();
+
+        total_size += series.capacity;
+    }
+
+    m_series_layout_dirty = false;
+    m_series_draws_dirty = true;
+    if (!total_size)
+    {
+        return;
+    }
+
+    // The store only grows, so removing or shrinking series does not reallocate it
+    if (total_size > m_series_capacity)
+    {
+        if (!m_per_series_colors)
+        {
+            m_series_buffer.Resize(1, sizeof(gplot::core::Color) * total_size);
+        }
+        m_series_buffer.Resize(0, sizeof(gplot::core::Vertex) * total_size);
+        m_series_capacity = total_size;
+    }
+
+    // Per-series colors are written with the draw commands instead
+    auto* colors_ptr = m_per_series_colors ? nullptr : m_series_buffer.MapBuffer<gplot::core::Color>(1, 0, total_size, GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT);
+    auto* vertex_ptr = m_series_buffer.MapBuffer<gplot::core::Vertex>(0, 0, total_size, GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT);
+
+    for (const auto& series : m_series)
+    {
+        const auto& drawn = GetDrawnVertices(series);
+        if (!series.alive || !IsPacked(series) || series.capacity == 0)
+        {
+            continue;
+        }
+
+        std::copy(drawn.begin(), drawn.end(), vertex_ptr + series.first);
+        if (colors_ptr)
+        {
+            std::fill(colors_ptr + series.first, colors_ptr + series.first + series.capacity, gplot::core::Color { VecToInt32(series.color) });
+        }
+    }
+
+    m_series_buffer.UnmapBuffer(0);
+    if (colors_ptr)
+    {
+        m_series_buffer.UnmapBuffer(1);
+    }
+}
+
+void Plotter::BuildSeriesDraws(glm::vec2 range)
+{
+    m_series_firsts.clear();
+    m_series_sizes.clear();
+
+    for (const auto& series : m_series)
+    {
+        if (!series.alive || !series.visible || !IsPacked(series) || series.count == 0)
+        {
+            continue;
+        }
+
+        const auto [begin, end] = GetSeriesDrawRange(series, range);
+        if (begin < end)
+        {
+            m_series_firsts.push_back(static_cast<GLint>(series.first + begin));
+            m_series_sizes.push_back(static_cast<GLsizei>(end - begin));
+        }
+    }
+}
+
+void Plotter::UpdateSeriesDraws(glm::vec2 range)
+{
+    // Only x-sorted series clip their command against the view, without them a camera move changes nothing
+    if (!m_series_draws_dirty && (!m_draws_follow_range || range == m_draws_range))
+    {
+        return;
+    }
+
+    m_draw_commands.clear();
+    m_draw_colors.clear();
+    m_draws_follow_range = false;
+
+    for (auto& series : m_series)
+    {
+        series.draw_index = NO_DRAW_COMMAND;
+        if (!series.alive || !IsPacked(series) || series.count == 0)
+        {
+            continue;
+        }
+
+        m_draws_follow_range |= series.sorted_x && series.decimation != Decimation::eMinMax;
+
+        const auto [begin, end] = GetSeriesDrawRange(series, range);
+        auto command = begin < end ? MakeDrawCommand(series.first + begin, end - begin) : gplot::graphics::IndirectBuffer::DrawArraysCommand { };
+
+        series.draw_index = m_draw_commands.size();
+        series.draw_instances = command.instance_count;
+        command.instance_count = series.visible ? command.instance_count : 0;
+        command.base_instance = static_cast<GLuint>(series.draw_index);
+
+        m_draw_commands.push_back(command);
+        m_draw_colors.push_back({ VecToInt32(series.color) });
+    }
+
+    m_series_draws.Update(m_draw_commands);
+    if (m_per_series_colors && !m_draw_colors.empty())
+    {
+        // Culling rebuilds the commands on every camera move, the table is only reallocated when it grows
+        if (m_draw_colors.size() > m_draw_color_capacity)
+        {
+            m_draw_color_capacity = std::max(m_draw_colors.size(), m_draw_color_capacity * 2);
+            m_series_buffer.Resize(1, sizeof(gplot::core::Color) * m_draw_color_capacity);
+        }
+        m_series_buffer.Update(1, sizeof(gplot::core::Color) * m_draw_colors.size(), m_draw_colors.data());
+    }
+    m_series_draws_dirty = false;
+    m_draws_range = range;
+}
+
+std::pair<size_t, size_t> Plotter::GetSeriesDrawRange(const LineSeries& series, glm::vec2 range)
+{
+    // Min/max views are already limited to the visible range
+    if (!series.sorted_x || series.decimation == Decimation::eMinMax)
+    {
+        return { 0, series.count };
+    }
+
+    const auto& drawn = GetDrawnVertices(series);
+    return FindVisibleRange(series.count, range.x, range.y, [&](size_t i) { return drawn[i].pos.x; });
+}
+
+const std::vector<gplot::core::Vertex>& Plotter::GetDrawnVertices(const LineSeries& series)
+{
+    return series.decimation == Decimation::eNone ? series.vertices : series.decimated;
+}
+
+void Plotter::WriteRing(LineSeries& series, std::span<const gplot::core::Vertex> vertices)
+{
+    const size_t capacity = series.ring_capacity;
+
+    // Only the newest samples can fit, everything currently in the ring gets overwritten
+    if (vertices.size() > capacity)
+    {
+        vertices = vertices.subspan(vertices.size() - capacity);
+        series.ring_head = 0;
+        series.ring_size = 0;
+    }
+
+    size_t tail = (series.ring_head + series.ring_size) % capacity;
+    size_t written = 0;
+    while (written < vertices.size())
+    {
+        const size_t count = std::min(vertices.size() - written, capacity - tail);
+        const auto* src = vertices.data() + written;
+
+        std::copy(src, src + count, series.vertices.begin() + static_cast<std::ptrdiff_t>(tail));
+        series.ring->Update(0, sizeof(gplot::core::Vertex) * count, src, sizeof(gplot::core::Vertex) * tail);
+
+        if (tail < RING_PADDING)
+        {
+            const size_t mirrored = std::min(count, RING_PADDING - tail);
+            series.ring->Update(0, sizeof(gplot::core::Vertex) * mirrored, src, sizeof(gplot::core::Vertex) * (capacity + tail));
+        }
+
+        written += count;
+        tail = (tail + count) % capacity;
+    }
+
+    const size_t new_size = series.ring_size + vertices.size();
+    if (new_size > capacity)
+    {
+        series.ring_head = (series.ring_head + new_size - capacity) % capacity;
+        series.ring_size = capacity;
+    }
+    else
+    {
+        series.ring_size = new_size;
+    }
+}
+
+void Plotter::FillRingColor(const LineSeries& series)
+{
+    const std::vector<gplot::core::Color> packed(series.ring_capacity + RING_PADDING, gplot::core::Color { VecToInt32(series.color) });
+    series.ring->Update(1, sizeof(gplot::core::Color) * packed.size(), packed.data());
+}
+
+void Plotter::RecordRing(gplot::graphics::Renderer& renderer, const LineSeries& series, glm::vec2 range)
+{
+    size_t begin = 0;
+    size_t end = series.ring_size;
+    if (series.sorted_x)
+    {
+        std::tie(begin, end) = FindVisibleRange(series.ring_size, range.x, range.y, [&](size_t i)
+        {
+            return series.vertices[(series.ring_head + i) % series.ring_capacity].pos.x;
+        });
+    }
+
+    if (begin >= end)
+    {
+        return;
+    }
+
+    const size_t start = (series.ring_head + begin) % series.ring_capacity;
+    const size_t size = end - begin;
+
+    std::array<GLint, 2> firsts { static_cast<GLint>(start), 0 };
+    std::array<GLsizei, 2> sizes { static_cast<GLsizei>(size), 0 };
+    size_t count = 1;
+
+    // A wrapped ring is drawn as two ranges, the first one runs into the mirrored padding to close the seam
+    if (start + size > series.ring_capacity)
+    {
+        const size_t tail = start + size - series.ring_capacity;
+        sizes[0] = static_cast<GLsizei>(series.ring_capacity - start + std::min(tail, RING_PADDING));
+        sizes[1] = static_cast<GLsizei>(tail);
+        count = 2;
+    }
+
+    RecordLineRanges(renderer, MakeLineState(*m_shader, *series.ring, m_color_texture, GL_R32UI), *series.ring, std::span(firsts.data(), count), std::span(sizes.data(), count));
+}
+
+void Plotter::RecordColormapped(gplot::graphics::Renderer& renderer, LineSeries& series, glm::vec2 range)
+{
+    // Vertices without a value, or values without a vertex, are left out
+    if (series.mapped_dirty)
+    {
+        series.count = std::min(series.vertices.size(), series.values.size());
+        if (series.count > 0)
+        {
+            series.mapped->Resize(0, sizeof(gplot::core::Vertex) * series.count);
+            series.mapped->Resize(1, sizeof(float) * series.count);
+            series.mapped->Update(0, sizeof(gplot::core::Vertex) * series.count, series.vertices.data());
+            series.mapped->Update(1, sizeof(float) * series.count, series.values.data());
+        }
+        series.mapped_dirty = false;
+    }
+
+    const auto [begin, end] = GetSeriesDrawRange(series, range);
+    if (begin >= end)
+    {
+        return;
+    }
+
+    const SeriesData data { series.value_range };
+    renderer.SetUniformBlock(SERIES_DATA_BINDING, &data, sizeof(data));
+
+    auto state = MakeLineState(GetColormapShader(), *series.mapped, m_value_texture, GL_R32F);
+    state.textures[0] = { GL_TEXTURE_1D, GetColormapTexture(series.colormap), COLORMAP_UNIT };
+
+    const GLint first = static_cast<GLint>(begin);
+    const GLsizei size = static_cast<GLsizei>(end - begin);
+    RecordLineRanges(renderer, state, *series.mapped, std::span(&first, 1), std::span(&size, 1));
+}
+
+void Plotter::UploadPrecise(LineSeries& series)
+{
+    const size_t count = series.points.size();
+    const size_t chunk_count = (count + PRECISE_CHUNK - 1) / PRECISE_CHUNK;
+
+    // Growing the store discards it, so every chunk is uploaded again
+    if (chunk_count > series.precise_capacity)
+    {
+        series.precise_capacity = std::max(chunk_count, 2 * series.precise_capacity);
+        series.precise->Resize(0, GetChunkVertexSize() * PRECISE_SLOT * series.precise_capacity);
+        series.precise->Resize(1, sizeof(gplot::core::Color) * PRECISE_SLOT * series.precise_capacity);
+        FillPreciseColor(series);
+        series.precise_valid = 0;
+    }
+
+    series.chunks.resize(chunk_count);
+    for (size_t i = series.precise_valid; i < chunk_count; i++)
+    {
+        // Adjacency needs the point before the chunk's first segment and the two after its last one
+        auto& chunk = series.chunks[i];
+        chunk.begin = std::max(i * PRECISE_CHUNK, size_t { 1 }) - 1;
+        chunk.end = std::min((i + 1) * PRECISE_CHUNK + 2, count);
+        chunk.detail_slot = NO_DETAIL_SLOT;
+
+        chunk.bounds = { };
+        for (size_t j = chunk.begin; j < chunk.end; j++)
+        {
+            chunk.bounds.min = glm::min(chunk.bounds.min, series.points[j]);
+            chunk.bounds.max = glm::max(chunk.bounds.max, series.points[j]);
+        }
+        chunk.origin = (chunk.bounds.min + chunk.bounds.max) / 2.0;
+        chunk.scale = glm::dvec2(1.0);
+
+        // Quantized chunks span their bounds, a flat axis keeps a unit step so it can still be divided by
+        if (m_chunk_encoding == ChunkEncoding::eUNorm16)
+        {
+            chunk.origin = chunk.bounds.min;
+            chunk.scale = (chunk.bounds.max - chunk.bounds.min) / QUANTIZED_STEPS;
+            chunk.scale = glm::mix(chunk.scale, glm::dvec2(1.0), glm::equal(chunk.scale, glm::dvec2(0.0)));
+            UploadQuantizedChunk(series, i);
+        }
+        else
+        {
+            UploadChunkOffsets(series, chunk, chunk.origin, *series.precise, i);
+        }
+    }
+
+    series.precise_valid = chunk_count;
+}
+
+void Plotter::UploadChunkOffsets(const LineSeries& series, const PreciseChunk& chunk, glm::dvec2 origin, const gplot::graphics::VertexBuffer& buffer, size_t slot)
+{
+    m_precise_scratch.resize(chunk.end - chunk.begin);
+    for (size_t j = chunk.begin; j < chunk.end; j++)
+    {
+        m_precise_scratch[j - chunk.begin].pos = glm::vec2(series.points[j] - origin);
+    }
+
+    buffer.Update(0, sizeof(gplot::core::Vertex) * m_precise_scratch.size(), m_precise_scratch.data(), sizeof(gplot::core::Vertex) * PRECISE_SLOT * slot);
+}
+
+void Plotter::UploadQuantizedChunk(const LineSeries& series, size_t index)
+{
+    const auto& chunk = series.chunks[index];
+
+    m_quantized_scratch.resize(chunk.end - chunk.begin);
+    for (size_t j = chunk.begin; j < chunk.end; j++)
+    {
+        const glm::dvec2 steps = glm::round((series.points[j] - chunk.origin) / chunk.scale);
+        m_quantized_scratch[j - chunk.begin] = glm::u16vec2(glm::clamp(steps, glm::dvec2(0.0), glm::dvec2(QUANTIZED_STEPS)));
+    }
+
+    series.precise->Update(0, sizeof(glm::u16vec2) * m_quantized_scratch.size(), m_quantized_scratch.data(), sizeof(glm::u16vec2) * PRECISE_SLOT * index);
+}
+
+void Plotter::FillPreciseColor(const LineSeries& series)
+{
+    const std::vector<gplot::core::Color> packed(PRECISE_SLOT * std::max(series.precise_capacity, series.detail_owners.size()), gplot::core::Color { VecToInt32(series.color) });
+    series.precise->Update(1, sizeof(gplot::core::Color) * PRECISE_SLOT * series.precise_capacity, packed.data());
+
+    if (series.detail)
+    {
+        series.detail->Update(1, sizeof(gplot::core::Color) * PRECISE_SLOT * series.detail_owners.size(), packed.data());
+    }
+}
+
+void Plotter::AssignDetailSlots(LineSeries& series, size_t needed)
+{
+    // Growing the detail store discards it, every chunk picks a new slot below
+    if (needed > series.detail_owners.size())
+    {
+        if (!series.detail)
+        {
+            series.detail = std::make_unique<gplot::graphics::VertexBuffer>(CreateVertexBufferDescriptor());
+        }
+
+        const size_t capacity = std::max(needed, 2 * series.detail_owners.size());
+        series.detail_owners.assign(capacity, NO_DETAIL_SLOT);
+        series.detail->Resize(0, sizeof(gplot::core::Vertex) * PRECISE_SLOT * capacity);
+        series.detail->Resize(1, sizeof(gplot::core::Color) * PRECISE_SLOT * capacity);
+        FillPreciseColor(series);
+    }
+
+    // Slots of chunks that no longer need detail, or were rebuilt since, are released
+    for (size_t slot = 0; slot < series.detail_owners.size(); slot++)
+    {
+        const size_t owner = series.detail_owners[slot];
+        if (owner != NO_DETAIL_SLOT && (owner >= series.chunks.size() || series.chunks[owner].detail_slot != slot || !series.chunks[owner].detailed))
+        {
+            series.detail_owners[slot] = NO_DETAIL_SLOT;
+        }
+    }
+
+    size_t free_slot = 0;
+    for (size_t i = 0; i < series.chunks.size(); i++)
+    {
+        auto& chunk = series.chunks[i];
+        if (!chunk.detailed)
+        {
+            continue;
+        }
+
+        if (chunk.detail_slot < series.detail_owners.size() && series.detail_owners[chunk.detail_slot] == i)
+        {
+            continue;
+        }
+
+        while (series.detail_owners[free_slot] != NO_DETAIL_SLOT)
+        {
+            free_slot++;
+        }
+
+        // The origin is invalid until the chunk is uploaded in RecordPrecise
+        series.detail_owners[free_slot] = i;
+        chunk.detail_slot = free_slot;
+        chunk.detail_origin = glm::dvec2(std::numeric_limits<double>::infinity());
+    }
+}
+
+void Plotter::RecordPrecise(gplot::graphics::Renderer& renderer, LineSeries& series, const CameraViewport& camera, FrameUniforms::Block frame)
+{
+    UploadPrecise(series);
+
+    const glm::dvec2 half = camera.proportions / 2.0;
+    const glm::dvec2 view_min = camera.center - half - static_cast<double>(frame.line_thickness);
+    const glm::dvec2 view_max = camera.center + half + static_cast<double>(frame.line_thickness);
+
+    const glm::ivec2 canvas = m_canvas_size.x > 0 && m_canvas_size.y > 0 ? m_canvas_size : glm::ivec2(DEFAULT_CANVAS_SIZE);
+    const glm::dvec2 tolerance = camera.proportions / glm::dvec2(canvas) * PRECISE_PIXEL_ERROR;
+
+    // Offsets of the vertices in view reach the origin's distance to the far side of the view
+    const auto needs_rebase = [&](glm::dvec2 origin)
+    {
+        const glm::dvec2 error = (glm::abs(origin - camera.center) + half) * static_cast<double>(std::numeric_limits<float>::epsilon());
+        return !(error.x <= tolerance.x && error.y <= tolerance.y);
+    };
+
+    // Quantized chunks whose steps show at this zoom are drawn from float offsets in the detail store instead
+    const bool quantized = m_chunk_encoding == ChunkEncoding::eUNorm16;
+
+    size_t detailed = 0;
+    for (auto& chunk : series.chunks)
+    {
+        chunk.visible = chunk.end - chunk.begin >= 4 && !glm::any(glm::lessThan(chunk.bounds.max, view_min)) && !glm::any(glm::greaterThan(chunk.bounds.min, view_max));
+        chunk.detailed = quantized && chunk.visible && glm::any(glm::greaterThan(chunk.scale, tolerance));
+        detailed += chunk.detailed;
+    }
+
+    if (detailed > 0)
+    {
+        AssignDetailSlots(series, detailed);
+    }
+
+    const auto restore = frame;
+    for (size_t i = 0; i < series.chunks.size(); i++)
+    {
+        auto& chunk = series.chunks[i];
+        if (!chunk.visible)
+        {
+            continue;
+        }
+
+        const gplot::graphics::VertexBuffer* buffer = series.precise.get();
+        GLint first = static_cast<GLint>(PRECISE_SLOT * i);
+        GLenum position_format = quantized ? GL_RG16 : GL_RG32F;
+
+        frame.view_matrix = MakeRelativeViewMatrix(camera, chunk.origin);
+        frame.position_scale = glm::vec2(chunk.scale * (quantized ? QUANTIZED_STEPS : 1.0));
+
+        if (chunk.detailed)
+        {
+            if (needs_rebase(chunk.detail_origin))
+            {
+                chunk.detail_origin = camera.center;
+                UploadChunkOffsets(series, chunk, chunk.detail_origin, *series.detail, chunk.detail_slot);
+            }
+
+            buffer = series.detail.get();
+            first = static_cast<GLint>(PRECISE_SLOT * chunk.detail_slot);
+            position_format = GL_RG32F;
+
+            frame.view_matrix = MakeRelativeViewMatrix(camera, chunk.detail_origin);
+            frame.position_scale = glm::vec2(1.0F);
+        }
+        else if (!quantized && needs_rebase(chunk.origin))
+        {
+            chunk.origin = camera.center;
+            UploadChunkOffsets(series, chunk, chunk.origin, *series.precise, i);
+            frame.view_matrix = MakeRelativeViewMatrix(camera, chunk.origin);
+        }
+
+        renderer.SetUniformBlock(FrameUniforms::BINDING, &frame, sizeof(frame));
+
+        const GLsizei size = static_cast<GLsizei>(chunk.end - chunk.begin);
+        RecordLineRanges(renderer, MakeLineState(*m_shader, *buffer, m_color_texture, GL_R32UI, position_format), *buffer, std::span(&first, 1), std::span(&size, 1));
+    }
+
+    // Series recorded after this one draw with the plot's own view again
+    renderer.SetUniformBlock(FrameUniforms::BINDING, &restore, sizeof(restore));
+}
+
+size_t Plotter::GetChunkVertexSize() const noexcept
+{
+    return m_chunk_encoding == ChunkEncoding::eUNorm16 ? sizeof(glm::u16vec2) : sizeof(gplot::core::Vertex);
 }
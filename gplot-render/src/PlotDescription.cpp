@@ -0,0 +1,128 @@
+#include "PlotDescription.hpp"
+
+#include <Core/DriveIO.hpp>
+
+#include <sstream>
+#include <iostream>
+
+namespace
+{
+    bool ReadPoints(std::istream& stream, std::vector<gplot::core::Vertex>& vertices)
+    {
+        float x;
+        float y;
+        while (stream >> x >> y)
+        {
+            vertices.push_back({ { x, y } });
+        }
+
+        return stream.eof();
+    }
+
+    std::string LoadText(std::string_view path)
+    {
+        gplot::core::DriveIO disk_io;
+
+        auto data = disk_io.Read(path);
+        if (!data.empty())
+        {
+            data.pop_back(); // DriveIO terminates the data with '\0'
+        }
+
+        return { data.begin(), data.end() };
+    }
+}
+
+std::optional<render::PlotDescription> render::ParsePlotDescription(std::string_view path)
+{
+    std::istringstream file(LoadText(path));
+
+    PlotDescription description;
+    SeriesDescription* inline_series = nullptr;
+
+    std::string line;
+    for (int line_number = 1; std::getline(file, line); line_number++)
+    {
+        line = line.substr(0, line.find('#'));
+
+        std::istringstream stream(line);
+        std::string directive;
+        if (!(stream >> directive))
+        {
+            continue;
+        }
+
+        bool valid = true;
+        if (inline_series)
+        {
+            if (directive == "end")
+            {
+                inline_series = nullptr;
+                continue;
+            }
+
+            stream.clear();
+            stream.seekg(0);
+            valid = ReadPoints(stream, inline_series->vertices);
+        }
+        else if (directive == "size")
+        {
+            valid = static_cast<bool>(stream >> description.size.x >> description.size.y) && description.size.x > 0 && description.size.y > 0;
+        }
+        else if (directive == "bounds")
+        {
+            valid = static_cast<bool>(stream >> description.bounds.min.x >> description.bounds.min.y >> description.bounds.max.x >> description.bounds.max.y);
+        }
+        else if (directive == "camera")
+        {
+            valid = static_cast<bool>(stream >> description.camera.center.x >> description.camera.center.y >> description.camera.proportions.x >> description.camera.proportions.y);
+        }
+        else if (directive == "thickness")
+        {
+            valid = static_cast<bool>(stream >> description.line_thickness);
+        }
+        else if (directive == "feather")
+        {
+            valid = static_cast<bool>(stream >> description.line_feather);
+        }
+        else if (directive == "background")
+        {
+            auto& color = description.background;
+            valid = static_cast<bool>(stream >> color.r >> color.g >> color.b >> color.a);
+        }
+        else if (directive == "series")
+        {
+            auto& series = description.series.emplace_back();
+            valid = static_cast<bool>(stream >> series.color.r >> series.color.g >> series.color.b >> series.color.a);
+
+            std::string points_path;
+            if (valid && stream >> points_path)
+            {
+                std::istringstream points(LoadText(points_path));
+                valid = ReadPoints(points, series.vertices);
+            }
+            else
+            {
+                inline_series = &series;
+            }
+        }
+        else
+        {
+            valid = false;
+        }
+
+        if (!valid)
+        {
+            std::cerr << path << ":" << line_number << ": invalid directive: " << line << std::endl;
+            return std::nullopt;
+        }
+    }
+
+    if (inline_series)
+    {
+        std::cerr << path << ": series is missing its 'end'" << std::endl;
+        return std::nullopt;
+    }
+
+    return description;
+}
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <Plotting/PlottingTypes.hpp>
+
+#include <string>
+#include <vector>
+#include <optional>
+#include <string_view>
+
+namespace render
+{
+    struct SeriesDescription
+    {
+        glm::vec4 color { 1.0F };
+        std::vector<gplot::core::Vertex> vertices;
+    };
+
+    // Plain-text plot description, one directive per line, '#' starts a comment:
+    //
+    //   size 1280 720                  output image size in pixels
+    //   bounds -1 -1 1 1               grid bounds, min x, min y, max x, max y
+    //   camera 0 0 2 2                 center x, center y, width, height of the visible area
+    //   thickness 0.002
+    //   feather 0.3
+    //   background 0 0 0 1
+    //   series 1 0 0 1 [points.txt]    color, points are read from the file or from the lines up to 'end'
+    //   -1 0.5
+    //   1 -0.5
+    //   end
+    //
+    // Point files hold whitespace separated x y pairs.
+    struct PlotDescription
+    {
+        glm::ivec2 size { 1280, 720 };
+        gplot::core::RectF bounds { { -1.0F, -1.0F }, { 1.0F, 1.0F } };
+        gplot::CameraViewport camera;
+        float line_thickness { 0.002F };
+        float line_feather { 0.3F };
+        glm::vec4 background { 0.0F, 0.0F, 0.0F, 1.0F };
+
+        std::vector<SeriesDescription> series;
+    };
+
+    [[nodiscard]] std::optional<PlotDescription> ParsePlotDescription(std::string_view path);
+}
@@ -0,0 +1,68 @@
+#include "PlotDescription.hpp"
+
+#include <Core/Image.hpp>
+#include <Plotting/Plotting.hpp>
+#include <Graphics/HeadlessContext.hpp>
+#include <Graphics/OffscreenCanvas.hpp>
+
+#include <glad/glad.h>
+
+#include <cstdio>
+#include <exception>
+
+// Renders a plot description to a PNG without a window: gplot-render <description> <output.png>
+int main(int argc, char* argv[])
+{
+    if (argc != 3)
+    {
+        std::fprintf(stderr, "usage: %s <description> <output.png>\n", argv[0]);
+        return 2;
+    }
+
+    const auto description = render::ParsePlotDescription(argv[1]);
+    if (!description)
+    {
+        return 1;
+    }
+
+    try
+    {
+        gplot::graphics::HeadlessContext context;
+
+        std::vector<std::uint8_t> pixels;
+        {
+            gplot::graphics::OffscreenCanvas canvas(description->size);
+            canvas.Bind();
+
+            const auto& background = description->background;
+            glClearColor(background.r, background.g, background.b, background.a);
+            glClear(GL_COLOR_BUFFER_BIT);
+
+            glEnable(GL_BLEND);
+            glBlendFuncSeparate(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA, GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
+
+            gplot::Plotter plotter;
+            plotter.SetCanvasSize(description->size.x, description->size.y);
+
+            for (const auto& series : description->series)
+            {
+                (void)plotter.AddSeries(series.vertices, series.color);
+            }
+
+            plotter.Render(description->bounds, description->camera, description->line_thickness, description->line_feather);
+            canvas.ReadPixels(pixels);
+        }
+
+        if (!gplot::core::WritePNG(argv[2], pixels.data(), description->size.x, description->size.y))
+        {
+            return 1;
+        }
+    }
+    catch (const std::exception& error)
+    {
+        std::fprintf(stderr, "%s\n", error.what());
+        return 1;
+    }
+
+    return 0;
+}
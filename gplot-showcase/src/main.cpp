@@ -1,5 +1,7 @@
 #include <Graphics/FBO.hpp>
+#include <Graphics/Shader.hpp>
 #include <Graphics/Texture.hpp>
+#include <Graphics/StateCache.hpp>
 #include <Plotting/Plotting.hpp>
 
 #include <SDL.h>
@@ -58,14 +60,10 @@ PointsData generate_sin_wave(int points, float start_x, float start_y, float ste
         vert.pos.x = start_x + (float(x) / x_scale);
         vert.pos.y = start_y + glm::sin(x) / y_scale;
 
-        res.bounds.min.x = std::min(res.bounds.min.x, vert.pos.x);
-        res.bounds.min.y = std::min(res.bounds.min.y, vert.pos.y);
-        res.bounds.max.x = std::max(res.bounds.max.x, vert.pos.x);
-        res.bounds.max.y = std::max(res.bounds.max.y, vert.pos.y);
-
         res.vertices.push_back(vert);
     }
 
+    res.bounds = gplot::core::ScanDataRange(res.vertices).bounds;
     return res;
 }
 
@@ -122,7 +120,15 @@ int main(int argc, char* argv[])
     int lines_count = 10;
     glm::vec4 pos_shift = { 0, 0, 1.0F, 1.0F };
 
+    // Shader binaries go to the per-user data directory, not the working directory
+    if (char* pref_path = SDL_GetPrefPath("gplot", "showcase"))
+    {
+        gplot::graphics::Shader::SetBinaryCacheDirectory(std::string(pref_path) + "shader");
+        SDL_free(pref_path);
+    }
+
     gplot::Plotter plotter;
+    plotter.SetCanvasSize(width, height);
 
     std::vector<std::vector<gplot::core::Vertex>> lines(lines_count);
 
@@ -140,6 +146,14 @@ int main(int argc, char* argv[])
         rect.max.y = std::max(rect.max.y, data.bounds.max.y);
     }
 
+    std::vector<gplot::SeriesHandle> series;
+    for (int i = 0; i < lines_count; i++)
+    {
+        series.push_back(plotter.AddSeries(lines[i], colors[i]));
+        plotter.SetSeriesSortedX(series.back(), true);
+        plotter.SetSeriesDecimation(series.back(), gplot::Decimation::eMinMax);
+    }
+
     gplot::CameraViewport viewport, backup;
     viewport.proportions.x = glm::abs(rect.min.x - rect.max.x);
     viewport.proportions.y = glm::abs(rect.min.y - rect.max.y);
@@ -219,6 +233,7 @@ int main(int argc, char* argv[])
 
                         canvas = std::make_unique<gplot::graphics::Texture>(gplot::graphics::Texture::texsize(width, height));
                         framebuffer.SetTexture(canvas->GetTextureId());
+                        plotter.SetCanvasSize(width, height);
                     }
                     break;
             }
@@ -229,13 +244,17 @@ int main(int argc, char* argv[])
         ImGui::NewFrame();
         ImGui::DockSpaceOverViewport();
 
+        gplot::graphics::StateCache::Get().ResetCounters();
+
         framebuffer.Bind();
         glClear(GL_COLOR_BUFFER_BIT);
 
-        plotter.PlotLines(lines, colors, rect, viewport, line_thickness, line_feather);
+        plotter.Render(rect, viewport, line_thickness, line_feather);
 
         gplot::graphics::FBO::Reset();
 
+        const auto state_counters = gplot::graphics::StateCache::Get().GetCounters();
+
         ImGui::Begin("Test");
 
         static bool _check = true;
@@ -259,10 +278,19 @@ int main(int argc, char* argv[])
             lines.resize(lines_count);
             colors = GenerateRandomColors(lines.size());
 
+            for (auto handle : series)
+            {
+                plotter.RemoveSeries(handle);
+            }
+            series.clear();
+
             for (int i = 0; i < lines_count; i++)
             {
                 auto data = generate_sin_wave(pts, -1.0F, -1.0F + float(i * 10) / lines_count, step, hor_scale, vert_scale);
                 lines[i] = data.vertices;
+                series.push_back(plotter.AddSeries(lines[i], colors[i]));
+                plotter.SetSeriesSortedX(series.back(), true);
+                plotter.SetSeriesDecimation(series.back(), gplot::Decimation::eMinMax);
 
                 rect.min.x = std::min(rect.min.x, data.bounds.min.x);
                 rect.min.y = std::min(rect.min.y, data.bounds.min.y);
@@ -283,6 +311,7 @@ int main(int argc, char* argv[])
         ImGui::Text("Plot bounds: min { %f, %f }, max { %f, %f }", rect.min.x, rect.min.y, rect.max.x, rect.max.y);
         ImGui::Text("Original vp: center { %f, %f }, proportions { %f, %f }", backup.center.x, backup.center.y, backup.proportions.x, backup.proportions.y);
         ImGui::Text("Viewport vp: center { %f, %f }, proportions { %f, %f }", viewport.center.x, viewport.center.y, viewport.proportions.x, viewport.proportions.y);
+        ImGui::Text("GL binds: %zu issued, %zu elided", state_counters.issued, state_counters.elided);
 
         ImGui::End();
 
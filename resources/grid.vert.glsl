@@ -4,7 +4,13 @@ layout (location = 0) in vec2 aPoint;
 layout (location = 1) in uint aColor;
 
 out vec4 VertColor;
-uniform mat4 uViewMatrix;
+layout (std140) uniform FrameData
+{
+    mat4 uViewMatrix;
+    float uLineThickness;
+    float uFeather;
+    vec2 uPositionScale;
+};
 
 void main()
 {
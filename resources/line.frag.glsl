@@ -4,7 +4,13 @@ out vec4 FragColor;
 in vec4 GeomColor;
 in float FragmentDist;
 
-uniform float uFeather = 0.1;
+layout (std140) uniform FrameData
+{
+    mat4 uViewMatrix;
+    float uLineThickness;
+    float uFeather;
+    vec2 uPositionScale;
+};
 
 void main()
 {
@@ -3,8 +3,13 @@
 layout (lines_adjacency) in;
 layout (triangle_strip, max_vertices = 4) out;
 
-uniform mat4 uViewMatrix;
-uniform float uLineThickness = 0.001;
+layout (std140) uniform FrameData
+{
+    mat4 uViewMatrix;
+    float uLineThickness;
+    float uFeather;
+    vec2 uPositionScale;
+};
 
 out vec4 GeomColor;
 out float FragmentDist;
@@ -1,17 +1,39 @@
 #version 330 core
 
 layout (location = 0) in vec2 aPoint;
+#ifdef COLORMAP
+// Scalar mapped through the colormap, uValueRange maps onto the texture's [0, 1]
+layout (location = 1) in float aValue;
+
+uniform sampler1D uColormap;
+
+layout (std140) uniform SeriesData
+{
+    vec2 uValueRange;
+};
+#else
 layout (location = 1) in uint aColor;
+#endif
 
 out vec4 VertColor;
-uniform mat4 uViewMatrix; // x, y -> position offset; z, w -> position scale by respective axes
+layout (std140) uniform FrameData
+{
+    mat4 uViewMatrix; // x, y -> position offset; z, w -> position scale by respective axes
+    float uLineThickness;
+    float uFeather;
+    vec2 uPositionScale; // applied before uViewMatrix, quantized positions arrive normalized
+};
 
 void main()
 {
+#ifdef COLORMAP
+    VertColor = texture(uColormap, clamp((aValue - uValueRange.x) / (uValueRange.y - uValueRange.x), 0.0, 1.0));
+#else
     VertColor.r = float((aColor >> 24) & 0xFFu) / 255.0F;
     VertColor.g = float((aColor >> 16) & 0xFFu) / 255.0F;
     VertColor.b = float((aColor >> 8 ) & 0xFFu) / 255.0F;
     VertColor.a = float((aColor >> 0 ) & 0xFFu) / 255.0F;
+#endif
 
-    gl_Position = uViewMatrix * vec4(aPoint, 0.0, 1.0);
+    gl_Position = uViewMatrix * vec4(aPoint * uPositionScale, 0.0, 1.0);
 }
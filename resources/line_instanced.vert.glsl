@@ -0,0 +1,73 @@
+#version 330 core
+
+// One instance per segment p1 -> p2, the four vertices of the quad are expanded here instead of in a geometry shader
+uniform samplerBuffer uPositions;
+#if defined(PER_SERIES_COLOR)
+// Entry of the per-series color table picked by the draw's base instance
+layout (location = 1) in uint aColor;
+#elif defined(COLORMAP)
+uniform samplerBuffer uValues;
+uniform sampler1D uColormap;
+
+layout (std140) uniform SeriesData
+{
+    vec2 uValueRange;
+};
+#else
+uniform usamplerBuffer uColors;
+#endif
+
+layout (std140) uniform FrameData
+{
+    mat4 uViewMatrix;
+    float uLineThickness;
+    float uFeather;
+    vec2 uPositionScale;
+};
+
+out vec4 GeomColor;
+out float FragmentDist;
+
+void main()
+{
+    // Draws start at vertex 4 * first segment start, so gl_VertexID carries the strip offset and the quad corner.
+    // The draws bind a VAO whose per-vertex arrays are disabled, only the per-instance color table stays enabled.
+    int corner = gl_VertexID & 3;
+    int index = gl_VertexID / 4 + gl_InstanceID;
+
+    vec2 p0 = (uViewMatrix * vec4(texelFetch(uPositions, index - 1).xy * uPositionScale, 0.0, 1.0)).xy;
+    vec2 p1 = (uViewMatrix * vec4(texelFetch(uPositions, index + 0).xy * uPositionScale, 0.0, 1.0)).xy;
+    vec2 p2 = (uViewMatrix * vec4(texelFetch(uPositions, index + 1).xy * uPositionScale, 0.0, 1.0)).xy;
+
+    vec2 directionPrev = normalize(p1 - p0);
+    vec2 directionNext = normalize(p2 - p1);
+
+    float eps = 0.001f;
+    vec2 line_thickness_min = (uViewMatrix * vec4(uLineThickness, uLineThickness, 0.0, 0.0)).xy;
+    vec2 line_thickness_processed = vec2(max(line_thickness_min.x, eps), max(line_thickness_min.y, eps));
+
+    // Same corner order as the strip emitted by line.geom.glsl: p1 +/-, then p2 +/-
+    bool segment_end = corner >= 2;
+    float side = (corner & 1) == 0 ? 1.0 : -1.0;
+
+    vec2 direction = segment_end ? directionNext : directionPrev;
+    vec2 perpendicular = vec2(-direction.y, direction.x) * line_thickness_processed;
+
+#if defined(COLORMAP)
+    float value = texelFetch(uValues, index + 1).r;
+    GeomColor = vec4(texture(uColormap, clamp((value - uValueRange.x) / (uValueRange.y - uValueRange.x), 0.0, 1.0)).rgb, 0.0);
+#else
+#if defined(PER_SERIES_COLOR)
+    uint color = aColor;
+#else
+    uint color = texelFetch(uColors, index + 1).r;
+#endif
+    GeomColor.r = float((color >> 24) & 0xFFu) / 255.0F;
+    GeomColor.g = float((color >> 16) & 0xFFu) / 255.0F;
+    GeomColor.b = float((color >> 8 ) & 0xFFu) / 255.0F;
+    GeomColor.a = 0.0;
+#endif
+
+    FragmentDist = side;
+    gl_Position = vec4((segment_end ? p2 : p1) + side * perpendicular, 0.0, 1.0);
+}